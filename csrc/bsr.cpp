@@ -0,0 +1,47 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/bsr_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__bsr_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__bsr_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+csr2bsr(torch::Tensor rowptr, torch::Tensor col, int64_t R, int64_t C) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return csr2bsr_cpu(rowptr, col, R, C);
+  }
+}
+
+SPARSE_API torch::Tensor bsr_spmm(torch::Tensor browptr, torch::Tensor bcol,
+                                  torch::Tensor bvalue, torch::Tensor mat,
+                                  int64_t M) {
+  if (mat.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return bsr_spmm_cpu(browptr, bcol, bvalue, mat, M);
+  }
+}
+
+static auto registry = torch::RegisterOperators()
+                           .op("torch_sparse::csr2bsr", &csr2bsr)
+                           .op("torch_sparse::bsr_spmm", &bsr_spmm);
@@ -0,0 +1,33 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/cat_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__cat_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__cat_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API torch::Tensor cat_offset(std::vector<torch::Tensor> tensors,
+                                    std::vector<int64_t> offsets,
+                                    bool skip_first) {
+  if (tensors.size() > 0 && tensors[0].device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return cat_offset_cpu(tensors, offsets, skip_first);
+  }
+}
+
+static auto registry =
+    torch::RegisterOperators().op("torch_sparse::cat_offset", &cat_offset);
@@ -0,0 +1,59 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/coalesce_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__coalesce_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__coalesce_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+coalesce(torch::Tensor rowptr, torch::Tensor col) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return coalesce_cpu(rowptr, col);
+  }
+}
+
+SPARSE_API bool is_sorted(torch::Tensor row, torch::Tensor col, bool strict) {
+  if (row.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return is_sorted_cpu(row, col, strict);
+  }
+}
+
+SPARSE_API torch::Tensor sort_coo(torch::Tensor row, torch::Tensor col,
+                                  int64_t M) {
+  if (row.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return sort_coo_cpu(row, col, M);
+  }
+}
+
+static auto registry = torch::RegisterOperators()
+                           .op("torch_sparse::coalesce", &coalesce)
+                           .op("torch_sparse::is_sorted", &is_sorted)
+                           .op("torch_sparse::sort_coo", &sort_coo);
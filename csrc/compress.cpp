@@ -0,0 +1,82 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/compress_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__compress_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__compress_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor>
+compress_csr(torch::Tensor rowptr, torch::Tensor col) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return compress_csr_cpu(rowptr, col);
+  }
+}
+
+SPARSE_API torch::Tensor decompress_csr(torch::Tensor rowptr,
+                                        torch::Tensor byteptr,
+                                        torch::Tensor data) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return decompress_csr_cpu(rowptr, byteptr, data);
+  }
+}
+
+SPARSE_API torch::Tensor
+compressed_spmm(torch::Tensor rowptr, torch::Tensor byteptr, torch::Tensor data,
+                torch::optional<torch::Tensor> optional_value,
+                torch::Tensor mat) {
+  if (mat.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return compressed_spmm_cpu(rowptr, byteptr, data, optional_value, mat);
+  }
+}
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor>
+compressed_sample_adj(torch::Tensor rowptr, torch::Tensor byteptr,
+                      torch::Tensor data, torch::Tensor idx,
+                      int64_t num_neighbors, bool replace) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return compressed_sample_adj_cpu(rowptr, byteptr, data, idx, num_neighbors,
+                                     replace);
+  }
+}
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("torch_sparse::compress_csr", &compress_csr)
+        .op("torch_sparse::decompress_csr", &decompress_csr)
+        .op("torch_sparse::compressed_spmm", &compressed_spmm)
+        .op("torch_sparse::compressed_sample_adj", &compressed_sample_adj);
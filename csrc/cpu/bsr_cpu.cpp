@@ -0,0 +1,166 @@
+#include "bsr_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+// Converts a CSR matrix into the blocked CSR (BSR) format with dense blocks
+// of shape `[R, C]`. Returns the block row pointer, the block column indices
+// and, for every non-zero entry, its position in the flattened block values
+// of shape `[nnzb * R * C]`, so that values can be scattered afterwards.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+csr2bsr_cpu(torch::Tensor rowptr, torch::Tensor col, int64_t R, int64_t C) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(R > 0 && C > 0);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+  auto Mb = (M + R - 1) / R;
+
+  // Collects the sorted and unique block columns of block row `br`:
+  auto block_cols = [&](int64_t br, std::vector<int64_t> &cols) {
+    cols.clear();
+    auto row_start = rowptr_data[br * R];
+    auto row_end = rowptr_data[std::min((br + 1) * R, M)];
+    for (auto e = row_start; e < row_end; e++)
+      cols.push_back(col_data[e] / C);
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+  };
+
+  auto browptr = torch::empty(Mb + 1, rowptr.options());
+  auto browptr_data = browptr.data_ptr<int64_t>();
+  browptr_data[0] = 0;
+
+  at::parallel_for(0, Mb, 1, [&](int64_t begin, int64_t end) {
+    std::vector<int64_t> cols;
+    for (auto br = begin; br < end; br++) {
+      block_cols(br, cols);
+      browptr_data[br + 1] = (int64_t)cols.size();
+    }
+  });
+
+  for (int64_t br = 0; br < Mb; br++)
+    browptr_data[br + 1] += browptr_data[br];
+
+  auto bcol = torch::empty(browptr_data[Mb], col.options());
+  auto pos = torch::empty(col.numel(), col.options());
+  auto bcol_data = bcol.data_ptr<int64_t>();
+  auto pos_data = pos.data_ptr<int64_t>();
+
+  at::parallel_for(0, Mb, 1, [&](int64_t begin, int64_t end) {
+    std::vector<int64_t> cols;
+    for (auto br = begin; br < end; br++) {
+      block_cols(br, cols);
+      std::copy(cols.begin(), cols.end(), bcol_data + browptr_data[br]);
+
+      for (auto r = br * R; r < std::min((br + 1) * R, M); r++) {
+        for (auto e = rowptr_data[r]; e < rowptr_data[r + 1]; e++) {
+          auto c = col_data[e];
+          auto idx = std::lower_bound(cols.begin(), cols.end(), c / C) -
+                     cols.begin();
+          pos_data[e] =
+              ((browptr_data[br] + idx) * R + (r - br * R)) * C + c % C;
+        }
+      }
+    }
+  });
+
+  return std::make_tuple(browptr, bcol, pos);
+}
+
+// Multiplies a BSR matrix with block values `bvalue` of shape
+// `[nnzb, R, C]` with `mat` of shape `[*, N, K]`. Every row of `mat` is
+// loaded once per block and reused for all `R` rows of the block.
+torch::Tensor bsr_spmm_cpu(torch::Tensor browptr, torch::Tensor bcol,
+                           torch::Tensor bvalue, torch::Tensor mat,
+                           int64_t M) {
+  CHECK_CPU(browptr);
+  CHECK_CPU(bcol);
+  CHECK_CPU(bvalue);
+  CHECK_CPU(mat);
+
+  CHECK_INPUT(browptr.dim() == 1);
+  CHECK_INPUT(bcol.dim() == 1);
+  CHECK_INPUT(bvalue.dim() == 3);
+  CHECK_INPUT(bvalue.size(0) == bcol.numel());
+  CHECK_INPUT(mat.dim() >= 2);
+  CHECK_INPUT(mat.scalar_type() == bvalue.scalar_type());
+
+  bvalue = bvalue.contiguous();
+  mat = mat.contiguous();
+
+  auto R = bvalue.size(1);
+  auto C = bvalue.size(2);
+  auto Mb = browptr.numel() - 1;
+  CHECK_INPUT(M <= Mb * R);
+  auto N = mat.size(-2);
+  auto K = mat.size(-1);
+  auto B = mat.numel() / (N * K);
+
+  auto sizes = mat.sizes().vec();
+  sizes[mat.dim() - 2] = M;
+  auto out = torch::empty(sizes, mat.options());
+
+  auto browptr_data = browptr.data_ptr<int64_t>();
+  auto bcol_data = bcol.data_ptr<int64_t>();
+
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, mat.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto bvalue_data = bvalue.data_ptr<scalar_t>();
+        auto mat_data = mat.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+
+        int64_t grain_size =
+            at::internal::GRAIN_SIZE /
+            (R * C * K *
+             std::max(bcol.numel() / std::max(Mb, (int64_t)1), (int64_t)1));
+        at::parallel_for(
+            0, B * Mb, std::max(grain_size, (int64_t)1),
+            [&](int64_t begin, int64_t end) {
+              std::vector<acc_t> vals(R * K);
+              int64_t b, br, n, rows;
+
+              for (auto i = begin; i < end; i++) {
+                b = i / Mb, br = i % Mb;
+                rows = std::min(R, M - br * R);
+
+                std::fill(vals.begin(), vals.end(), (acc_t)0);
+
+                for (auto e = browptr_data[br]; e < browptr_data[br + 1];
+                     e++) {
+                  auto block = bvalue_data + e * R * C;
+                  for (int64_t c = 0; c < C; c++) {
+                    n = bcol_data[e] * C + c;
+                    if (n >= N) // Padding of the last block column.
+                      break;
+                    auto mat_row = mat_data + (b * N + n) * K;
+                    for (int64_t r = 0; r < rows; r++) {
+                      auto val = (acc_t)block[r * C + c];
+                      auto vals_row = vals.data() + r * K;
+                      for (int64_t k = 0; k < K; k++)
+                        vals_row[k] += val * (acc_t)mat_row[k];
+                    }
+                  }
+                }
+
+                for (int64_t r = 0; r < rows; r++) {
+                  auto out_row = out_data + (b * M + br * R + r) * K;
+                  for (int64_t k = 0; k < K; k++)
+                    out_row[k] = (scalar_t)vals[r * K + k];
+                }
+              }
+            });
+      });
+
+  return out;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+csr2bsr_cpu(torch::Tensor rowptr, torch::Tensor col, int64_t R, int64_t C);
+
+torch::Tensor bsr_spmm_cpu(torch::Tensor browptr, torch::Tensor bcol,
+                           torch::Tensor bvalue, torch::Tensor mat, int64_t M);
@@ -0,0 +1,44 @@
+#include "cat_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+// Concatenates a list of index tensors while adding `offsets[i]` to all
+// entries of `tensors[i]`. In case `skip_first` is set, the first entry of
+// every tensor except the first one is dropped (as needed for concatenating
+// compressed pointer vectors such as `rowptr`). Output positions are
+// obtained by a single prefix sum over sizes, followed by a single parallel
+// copy, which avoids a separate kernel launch per tensor.
+torch::Tensor cat_offset_cpu(std::vector<torch::Tensor> tensors,
+                             std::vector<int64_t> offsets, bool skip_first) {
+  CHECK_INPUT(tensors.size() > 0);
+  CHECK_INPUT(tensors.size() == offsets.size());
+
+  auto T = (int64_t)tensors.size();
+  std::vector<int64_t> starts(T), ptr(T + 1, 0);
+  for (int64_t i = 0; i < T; i++) {
+    CHECK_CPU(tensors[i]);
+    CHECK_INPUT(tensors[i].dim() == 1);
+    CHECK_INPUT(tensors[i].scalar_type() == at::ScalarType::Long);
+    tensors[i] = tensors[i].contiguous();
+    starts[i] = skip_first && i > 0 && tensors[i].numel() > 0 ? 1 : 0;
+    ptr[i + 1] = ptr[i] + tensors[i].numel() - starts[i];
+  }
+
+  auto out = torch::empty(ptr[T], tensors[0].options());
+  auto out_data = out.data_ptr<int64_t>();
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(ptr[T] / std::max(T, (int64_t)1), (int64_t)1);
+  at::parallel_for(0, T, grain_size, [&](int64_t begin, int64_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto src_data = tensors[i].data_ptr<int64_t>() + starts[i];
+      auto offset = offsets[i];
+      for (auto j = ptr[i]; j < ptr[i + 1]; j++)
+        out_data[j] = src_data[j - ptr[i]] + offset;
+    }
+  });
+
+  return out;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "../extensions.h"
+
+torch::Tensor cat_offset_cpu(std::vector<torch::Tensor> tensors,
+                             std::vector<int64_t> offsets, bool skip_first);
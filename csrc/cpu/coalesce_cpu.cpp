@@ -0,0 +1,147 @@
+#include "coalesce_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include <atomic>
+
+#include "utils.h"
+
+// Removes duplicated entries of a (row-sorted) CSR matrix. Since duplicates
+// are stored consecutively within each row, they can be detected in
+// parallel across rows without building any global keys. Besides the
+// coalesced pattern, it returns the segment pointer `ptr` of shape
+// `[nnz_out + 1]` into the input entries, so that values can be reduced
+// afterwards via `segment_csr` using any reduction.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+coalesce_cpu(torch::Tensor rowptr, torch::Tensor col) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(col.numel() / std::max(M, (int64_t)1),
+                                (int64_t)1);
+
+  auto out_rowptr = torch::zeros(M + 1, rowptr.options());
+  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t count;
+    for (auto m = begin; m < end; m++) {
+      count = 0;
+      for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++)
+        count += e == rowptr_data[m] || col_data[e] != col_data[e - 1];
+      out_rowptr_data[m + 1] = count;
+    }
+  });
+  out_rowptr = out_rowptr.cumsum(0);
+  out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+
+  auto out_col = torch::empty(out_rowptr_data[M], col.options());
+  auto ptr = torch::empty(out_rowptr_data[M] + 1, col.options());
+  auto out_col_data = out_col.data_ptr<int64_t>();
+  auto ptr_data = ptr.data_ptr<int64_t>();
+  ptr_data[out_rowptr_data[M]] = col.numel();
+
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t offset;
+    for (auto m = begin; m < end; m++) {
+      offset = out_rowptr_data[m];
+      for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+        if (e == rowptr_data[m] || col_data[e] != col_data[e - 1]) {
+          out_col_data[offset] = col_data[e];
+          ptr_data[offset] = e;
+          offset++;
+        }
+      }
+    }
+  });
+
+  return std::make_tuple(out_rowptr, out_col, ptr);
+}
+
+// Checks whether COO indices are sorted in row-major order (and do not
+// contain any duplicates in case `strict` is set), without computing any
+// potentially overflowing `row * N + col` keys.
+bool is_sorted_cpu(torch::Tensor row, torch::Tensor col, bool strict) {
+  CHECK_CPU(row);
+  CHECK_CPU(col);
+
+  CHECK_INPUT(row.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(row.numel() == col.numel());
+
+  row = row.contiguous(), col = col.contiguous();
+
+  auto row_data = row.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+
+  std::atomic<bool> sorted(true);
+  at::parallel_for(
+      1, std::max(col.numel(), (int64_t)1), at::internal::GRAIN_SIZE,
+      [&](int64_t begin, int64_t end) {
+        for (auto e = begin; e < end && sorted; e++) {
+          if (row_data[e - 1] > row_data[e] ||
+              (row_data[e - 1] == row_data[e] &&
+               (col_data[e - 1] > col_data[e] ||
+                (strict && col_data[e - 1] == col_data[e])))) {
+            sorted = false;
+          }
+        }
+      });
+
+  return sorted;
+}
+
+// Returns the permutation that sorts COO indices by `(row, col)`. Entries get
+// bucketed by row via a stable counting sort, after which every row segment
+// is sorted by column in parallel. In contrast to sorting `row * N + col`,
+// this does not overflow for large sparse sizes.
+torch::Tensor sort_coo_cpu(torch::Tensor row, torch::Tensor col, int64_t M) {
+  CHECK_CPU(row);
+  CHECK_CPU(col);
+
+  CHECK_INPUT(row.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(row.numel() == col.numel());
+
+  row = row.contiguous(), col = col.contiguous();
+
+  auto row_data = row.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto E = col.numel();
+
+  std::vector<int64_t> rowptr(M + 1, 0);
+  for (int64_t e = 0; e < E; e++) {
+    CHECK_INPUT(row_data[e] >= 0 && row_data[e] < M);
+    rowptr[row_data[e] + 1]++;
+  }
+  for (int64_t m = 0; m < M; m++)
+    rowptr[m + 1] += rowptr[m];
+
+  auto perm = torch::empty(E, col.options());
+  auto perm_data = perm.data_ptr<int64_t>();
+  std::vector<int64_t> offset(rowptr.begin(), rowptr.end() - 1);
+  for (int64_t e = 0; e < E; e++)
+    perm_data[offset[row_data[e]]++] = e;
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(E / std::max(M, (int64_t)1), (int64_t)1);
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    for (auto m = begin; m < end; m++) {
+      std::stable_sort(perm_data + rowptr[m], perm_data + rowptr[m + 1],
+                       [&](const int64_t &a, const int64_t &b) {
+                         return col_data[a] < col_data[b];
+                       });
+    }
+  });
+
+  return perm;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+coalesce_cpu(torch::Tensor rowptr, torch::Tensor col);
+
+bool is_sorted_cpu(torch::Tensor row, torch::Tensor col, bool strict);
+
+torch::Tensor sort_coo_cpu(torch::Tensor row, torch::Tensor col, int64_t M);
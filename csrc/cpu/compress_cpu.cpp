@@ -0,0 +1,313 @@
+#include "compress_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "sample_utils.h"
+
+// Column indices of every row are stored as a byte stream: The first column
+// is stored as is, and all following ones as the difference to their
+// predecessor. Every number is encoded as a varint, i.e., in groups of seven
+// bits, where the highest bit of a byte signals that more bytes follow.
+// Rows are addressed via `byteptr`, while `rowptr` is kept to address values.
+
+inline int64_t varint_size(uint64_t x) {
+  int64_t size = 1;
+  while (x >= 128) {
+    x >>= 7;
+    size++;
+  }
+  return size;
+}
+
+inline uint8_t *varint_write(uint8_t *out, uint64_t x) {
+  while (x >= 128) {
+    *out++ = (uint8_t)(x | 128);
+    x >>= 7;
+  }
+  *out++ = (uint8_t)x;
+  return out;
+}
+
+inline const uint8_t *varint_read(const uint8_t *in, uint64_t *x) {
+  uint64_t out = 0;
+  int shift = 0;
+  while (*in & 128) {
+    out |= (uint64_t)(*in++ & 127) << shift;
+    shift += 7;
+  }
+  *x = out | ((uint64_t)*in++ << shift);
+  return in;
+}
+
+// Decodes the column indices of row `r` into `out`:
+inline void decode_row(const int64_t *rowptr_data, const int64_t *byteptr_data,
+                       const uint8_t *data, int64_t r, int64_t *out) {
+  auto in = data + byteptr_data[r];
+  uint64_t x;
+  int64_t c = 0;
+  for (int64_t j = 0; j < rowptr_data[r + 1] - rowptr_data[r]; j++) {
+    in = varint_read(in, &x);
+    c += (int64_t)x;
+    out[j] = c;
+  }
+}
+
+std::tuple<torch::Tensor, torch::Tensor> compress_csr_cpu(torch::Tensor rowptr,
+                                                          torch::Tensor col) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+
+  auto byteptr = torch::empty(M + 1, rowptr.options());
+  auto byteptr_data = byteptr.data_ptr<int64_t>();
+  byteptr_data[0] = 0;
+
+  at::parallel_for(0, M, at::internal::GRAIN_SIZE, [&](int64_t b, int64_t e) {
+    for (auto r = b; r < e; r++) {
+      int64_t size = 0, prev = 0;
+      for (auto i = rowptr_data[r]; i < rowptr_data[r + 1]; i++) {
+        if (col_data[i] < prev)
+          AT_ERROR("Column indices need to be sorted within rows");
+        size += varint_size((uint64_t)(col_data[i] - prev));
+        prev = col_data[i];
+      }
+      byteptr_data[r + 1] = size;
+    }
+  });
+
+  for (int64_t r = 0; r < M; r++)
+    byteptr_data[r + 1] += byteptr_data[r];
+
+  auto data = torch::empty(byteptr_data[M], rowptr.options().dtype(at::kByte));
+  auto data_data = data.data_ptr<uint8_t>();
+
+  at::parallel_for(0, M, at::internal::GRAIN_SIZE, [&](int64_t b, int64_t e) {
+    for (auto r = b; r < e; r++) {
+      auto out = data_data + byteptr_data[r];
+      int64_t prev = 0;
+      for (auto i = rowptr_data[r]; i < rowptr_data[r + 1]; i++) {
+        out = varint_write(out, (uint64_t)(col_data[i] - prev));
+        prev = col_data[i];
+      }
+    }
+  });
+
+  return std::make_tuple(byteptr, data);
+}
+
+torch::Tensor decompress_csr_cpu(torch::Tensor rowptr, torch::Tensor byteptr,
+                                 torch::Tensor data) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(byteptr);
+  CHECK_CPU(data);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(byteptr.numel() == rowptr.numel());
+  CHECK_INPUT(data.scalar_type() == at::kByte);
+
+  rowptr = rowptr.contiguous(), byteptr = byteptr.contiguous();
+  data = data.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto byteptr_data = byteptr.data_ptr<int64_t>();
+  auto data_data = data.data_ptr<uint8_t>();
+  auto M = rowptr.numel() - 1;
+
+  auto col = torch::empty(rowptr_data[M], rowptr.options());
+  auto col_data = col.data_ptr<int64_t>();
+
+  at::parallel_for(0, M, at::internal::GRAIN_SIZE, [&](int64_t b, int64_t e) {
+    for (auto r = b; r < e; r++)
+      decode_row(rowptr_data, byteptr_data, data_data, r,
+                 col_data + rowptr_data[r]);
+  });
+
+  return col;
+}
+
+// Sum-reduces `mat` of shape `[*, N, K]` while decoding column indices on
+// the fly, so that the full column vector never gets materialized.
+torch::Tensor
+compressed_spmm_cpu(torch::Tensor rowptr, torch::Tensor byteptr,
+                    torch::Tensor data,
+                    torch::optional<torch::Tensor> optional_value,
+                    torch::Tensor mat) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(byteptr);
+  CHECK_CPU(data);
+  if (optional_value.has_value())
+    CHECK_CPU(optional_value.value());
+  CHECK_CPU(mat);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(byteptr.numel() == rowptr.numel());
+  CHECK_INPUT(data.scalar_type() == at::kByte);
+  if (optional_value.has_value()) {
+    CHECK_INPUT(optional_value.value().dim() == 1);
+    optional_value = optional_value.value().contiguous();
+  }
+  CHECK_INPUT(mat.dim() >= 2);
+
+  rowptr = rowptr.contiguous(), byteptr = byteptr.contiguous();
+  data = data.contiguous(), mat = mat.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto byteptr_data = byteptr.data_ptr<int64_t>();
+  auto data_data = data.data_ptr<uint8_t>();
+
+  auto M = rowptr.numel() - 1;
+  auto N = mat.size(-2);
+  auto K = mat.size(-1);
+  auto B = mat.numel() / (N * K);
+
+  auto sizes = mat.sizes().vec();
+  sizes[mat.dim() - 2] = M;
+  auto out = torch::empty(sizes, mat.options());
+
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, mat.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        scalar_t *value_data = nullptr;
+        auto mat_data = mat.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+
+        AT_DISPATCH_HAS_VALUE(optional_value, [&] {
+          if (HAS_VALUE) {
+            value_data = optional_value.value().data_ptr<scalar_t>();
+          }
+
+          int64_t grain_size =
+              at::internal::GRAIN_SIZE /
+              (K * std::max(rowptr_data[M] / std::max(M, (int64_t)1),
+                            (int64_t)1));
+          at::parallel_for(
+              0, B * M, std::max(grain_size, (int64_t)1),
+              [&](int64_t begin, int64_t end) {
+                std::vector<acc_t> vals(K);
+                acc_t val = (acc_t)1;
+                uint64_t x;
+                int64_t b, m, c;
+
+                for (auto i = begin; i < end; i++) {
+                  b = i / M, m = i % M;
+
+                  std::fill(vals.begin(), vals.end(), (acc_t)0);
+
+                  const uint8_t *in = data_data + byteptr_data[m];
+                  c = 0;
+                  for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+                    in = varint_read(in, &x);
+                    c += (int64_t)x;
+                    if (HAS_VALUE)
+                      val = (acc_t)value_data[e];
+                    auto mat_row = mat_data + (b * N + c) * K;
+                    for (int64_t k = 0; k < K; k++)
+                      vals[k] += val * (acc_t)mat_row[k];
+                  }
+
+                  auto out_row = out_data + i * K;
+                  for (int64_t k = 0; k < K; k++)
+                    out_row[k] = (scalar_t)vals[k];
+                }
+              });
+        });
+      });
+
+  return out;
+}
+
+// Same as `sample_adj_cpu`, but decodes the rows of sampled nodes on the fly.
+// Returns `rowptr`, `col`, `n_id`, `e_id`.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+compressed_sample_adj_cpu(torch::Tensor rowptr, torch::Tensor byteptr,
+                          torch::Tensor data, torch::Tensor idx,
+                          int64_t num_neighbors, bool replace) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(byteptr);
+  CHECK_CPU(data);
+  CHECK_CPU(idx);
+  CHECK_INPUT(idx.dim() == 1);
+  CHECK_INPUT(byteptr.numel() == rowptr.numel());
+  CHECK_INPUT(data.scalar_type() == at::kByte);
+
+  rowptr = rowptr.contiguous(), byteptr = byteptr.contiguous();
+  data = data.contiguous(), idx = idx.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto byteptr_data = byteptr.data_ptr<int64_t>();
+  auto data_data = data.data_ptr<uint8_t>();
+  auto idx_data = idx.data_ptr<int64_t>();
+  auto M = idx.numel();
+
+  int64_t grain_size =
+      at::internal::GRAIN_SIZE /
+      std::max(num_neighbors < 0
+                   ? (rowptr_data[rowptr.numel() - 1] / std::max(M, (int64_t)1))
+                   : num_neighbors,
+               (int64_t)1);
+
+  // Count the number of sampled neighbors per row:
+  auto out_rowptr = torch::zeros(M + 1, rowptr.options());
+  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t n;
+    for (auto i = begin; i < end; i++) {
+      n = idx_data[i];
+      out_rowptr_data[i + 1] = sample_count(
+          rowptr_data[n + 1] - rowptr_data[n], num_neighbors, replace);
+    }
+  });
+  out_rowptr = out_rowptr.cumsum(0);
+  out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+
+  // Decode the rows of sampled nodes, and fill in their sampled edge IDs and
+  // (global) columns in place:
+  int64_t E = out_rowptr_data[M];
+  auto out_e_id = torch::empty(E, rowptr.options());
+  auto out_e_id_data = out_e_id.data_ptr<int64_t>();
+  std::vector<int64_t> sampled_cols(E);
+
+  const auto seed = std::random_device{}(); // Initialize random seed.
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    std::mt19937 generator(seed + begin);
+    std::vector<int64_t> row_cols; // Decoded columns of the current row.
+    int64_t n, row_start, row_count, offset, count;
+    for (auto i = begin; i < end; i++) {
+      n = idx_data[i];
+      row_start = rowptr_data[n];
+      row_count = rowptr_data[n + 1] - row_start;
+      offset = out_rowptr_data[i];
+      count = out_rowptr_data[i + 1] - offset;
+      auto *out = out_e_id_data + offset;
+      if (count == 0)
+        continue;
+
+      row_cols.resize(row_count);
+      decode_row(rowptr_data, byteptr_data, data_data, n, row_cols.data());
+
+      sample_offsets(row_count, count, num_neighbors, replace, generator, out);
+      for (int64_t j = 0; j < count; j++) {
+        sampled_cols[offset + j] = row_cols[out[j]];
+        out[j] += row_start;
+      }
+    }
+  });
+
+  // Assign local node indices in order of appearance, starting with `idx`,
+  // and sort every row by local node index:
+  torch::Tensor out_col, out_n_id;
+  std::tie(out_col, out_n_id) =
+      relabel_sampled(idx_data, M, out_rowptr_data, out_e_id, grain_size,
+                      [&](int64_t e) { return sampled_cols[e]; });
+
+  return std::make_tuple(out_rowptr, out_col, out_n_id, out_e_id);
+}
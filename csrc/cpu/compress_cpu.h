@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor> compress_csr_cpu(torch::Tensor rowptr,
+                                                          torch::Tensor col);
+
+torch::Tensor decompress_csr_cpu(torch::Tensor rowptr, torch::Tensor byteptr,
+                                 torch::Tensor data);
+
+torch::Tensor
+compressed_spmm_cpu(torch::Tensor rowptr, torch::Tensor byteptr,
+                    torch::Tensor data,
+                    torch::optional<torch::Tensor> optional_value,
+                    torch::Tensor mat);
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+compressed_sample_adj_cpu(torch::Tensor rowptr, torch::Tensor byteptr,
+                          torch::Tensor data, torch::Tensor idx,
+                          int64_t num_neighbors, bool replace);
@@ -1,10 +1,8 @@
 #include "hgt_sample_cpu.h"
 
-#include "utils.h"
+#include <random>
 
-#ifdef _WIN32
-#include <process.h>
-#endif
+#include "utils.h"
 
 #define MAX_NEIGHBORS 50
 
@@ -21,80 +19,161 @@ edge_t split(const rel_t &rel_type) {
   return make_tuple(result[0], result[1], result[2]);
 }
 
-void update_budget_(
-    unordered_map<node_t, unordered_map<int64_t, float>> *budget_dict,
-    const node_t &node_type, const vector<int64_t> &samples,
-    const unordered_map<node_t, unordered_map<int64_t, int64_t>>
-        &to_local_node_dict,
-    const unordered_map<rel_t, edge_t> &to_edge_type,
-    const c10::Dict<rel_t, torch::Tensor> &colptr_dict,
-    const c10::Dict<rel_t, torch::Tensor> &row_dict) {
+// Sampling state of a single node type. Local indices and budgets are held
+// in dense arrays in case the number of nodes of that type is known from a
+// `colptr`, and in hash maps otherwise, so that no call needs to scan `row`
+// to determine it. `touched` lists the nodes with a non-zero budget that have
+// not been sampled yet:
+struct NodeState {
+  vector<int64_t> nodes;
+  vector<int64_t> touched;
+
+  bool dense = false;
+  vector<int64_t> to_local_vec;
+  vector<float> budget_vec;
+  unordered_map<int64_t, int64_t> to_local_map;
+  unordered_map<int64_t, float> budget_map;
+
+  void init(const int64_t num_nodes) {
+    dense = num_nodes >= 0;
+    if (dense) {
+      to_local_vec.resize(num_nodes, -1);
+      budget_vec.resize(num_nodes, 0.f);
+    }
+  }
 
-  if (samples.empty())
-    return;
+  int64_t to_local(const int64_t v) const {
+    if (dense)
+      return to_local_vec[v];
+    const auto iter = to_local_map.find(v);
+    return iter == to_local_map.end() ? -1 : iter->second;
+  }
 
-  for (const auto &kv : colptr_dict) {
-    const auto &rel_type = kv.key();
-    const auto &edge_type = to_edge_type.at(rel_type);
-    const auto &src_node_type = get<0>(edge_type);
-    const auto &dst_node_type = get<2>(edge_type);
-
-    if (node_type != dst_node_type)
-      continue;
-
-    const auto &to_local_src_node = to_local_node_dict.at(src_node_type);
-    const auto *colptr_data = kv.value().data_ptr<int64_t>();
-    const auto *row_data = row_dict.at(rel_type).data_ptr<int64_t>();
-    auto &src_budget = budget_dict->at(src_node_type);
-
-    for (const auto &w : samples) {
-      const auto &col_start = colptr_data[w], &col_end = colptr_data[w + 1];
-      if (col_end - col_start > MAX_NEIGHBORS) {
-        // There might be same neighbors with large neighborhood sizes.
-        // In order to prevent that we fill our budget with many values of low
-        // probability, we instead sample a fixed amount without replacement:
-        auto indices = choice(col_end - col_start, MAX_NEIGHBORS, false);
-        auto *indices_data = indices.data_ptr<int64_t>();
-        for (int64_t i = 0; i < indices.numel(); i++) {
-          const auto &v = row_data[col_start + indices_data[i]];
-          // Only add the neighbor in case we have not yet seen it before:
-          if (to_local_src_node.find(v) == to_local_src_node.end())
-            src_budget[v] += 1.f / float(MAX_NEIGHBORS);
-        }
+  void add_node(const int64_t v) {
+    if (dense)
+      to_local_vec[v] = nodes.size();
+    else
+      to_local_map[v] = nodes.size();
+    nodes.push_back(v);
+  }
 
-      } else if (col_end != col_start) {
-        const auto inv_deg = 1.f / float(col_end - col_start);
-        for (int64_t i = col_start; i < col_end; i++) {
-          const auto &v = row_data[i];
-          // Only add the neighbor in case we have not yet seen it before:
-          if (to_local_src_node.find(v) == to_local_src_node.end())
-            src_budget[v] += inv_deg;
+  float &budget(const int64_t v) {
+    return dense ? budget_vec[v] : budget_map[v];
+  }
+
+  void erase_budget(const int64_t v) {
+    if (dense)
+      budget_vec[v] = 0.f;
+    else
+      budget_map.erase(v);
+  }
+};
+
+struct Relation {
+  rel_t rel_type;
+  int64_t src, dst;
+  const int64_t *colptr_data;
+  const int64_t *row_data;
+};
+
+// Draws `MAX_NEIGHBORS` distinct offsets out of `[0, population)` via Robert
+// Floyd's algorithm, without allocating:
+void draw_neighbors(const int64_t population, mt19937 &generator,
+                    int64_t *out) {
+  for (int64_t i = population - MAX_NEIGHBORS, k = 0; i < population;
+       i++, k++) {
+    int64_t j = uniform_int_distribution<int64_t>(0, i)(generator);
+    if (find(out, out + k, j) != out + k)
+      j = i;
+    out[k] = j;
+  }
+}
+
+inline void add_budget_(NodeState *state, const int64_t v, const float x) {
+  // Only add the neighbor in case we have not yet seen it before:
+  if (state->to_local(v) >= 0)
+    return;
+  auto &budget = state->budget(v);
+  if (budget == 0.f)
+    state->touched.push_back(v);
+  budget += x;
+}
+
+// Adds the neighbors of the newly sampled nodes `nodes[begin[t]:]` of every
+// node type `t` to the budget. Every thread owns the budgets of the source
+// node types it processes, so that node types can be updated in parallel.
+void update_budget_(vector<NodeState> *states,
+                    const vector<Relation> &relations,
+                    const vector<int64_t> &begin,
+                    vector<mt19937> *generators) {
+
+  at::parallel_for(0, states->size(), 1, [&](int64_t b, int64_t e) {
+    int64_t indices[MAX_NEIGHBORS];
+    for (int64_t s = b; s < e; s++) {
+      auto &src_state = states->at(s);
+      auto &generator = generators->at(s);
+      for (const auto &relation : relations) {
+        if (relation.src != s)
+          continue;
+
+        const auto &samples = states->at(relation.dst).nodes;
+        const auto *colptr_data = relation.colptr_data;
+        const auto *row_data = relation.row_data;
+        for (int64_t i = begin[relation.dst]; i < (int64_t)samples.size();
+             i++) {
+          const auto &w = samples[i];
+          const auto &col_start = colptr_data[w], &col_end = colptr_data[w + 1];
+          if (col_end - col_start > MAX_NEIGHBORS) {
+            // There might be same neighbors with large neighborhood sizes.
+            // In order to prevent that we fill our budget with many values of
+            // low probability, we instead sample a fixed amount without
+            // replacement:
+            draw_neighbors(col_end - col_start, generator, indices);
+            for (int64_t k = 0; k < MAX_NEIGHBORS; k++)
+              add_budget_(&src_state, row_data[col_start + indices[k]],
+                          1.f / float(MAX_NEIGHBORS));
+          } else if (col_end != col_start) {
+            const auto inv_deg = 1.f / float(col_end - col_start);
+            for (int64_t k = col_start; k < col_end; k++)
+              add_budget_(&src_state, row_data[k], inv_deg);
+          }
         }
       }
     }
-  }
+  });
 }
 
-vector<int64_t> sample_from(const unordered_map<int64_t, float> &budget,
-                            const int64_t num_samples) {
-  vector<int64_t> indices;
-  vector<float> weights;
-  indices.reserve(budget.size());
-  weights.reserve(budget.size());
-  for (const auto &kv : budget) {
-    indices.push_back(kv.first);
-    weights.push_back(kv.second * kv.second);
+// Samples `num_samples` nodes without replacement with probabilities
+// proportional to their squared budget via Efraimidis-Spirakis keys, adds
+// them to the sampled nodes and erases them from the budget.
+void sample_from_(NodeState *state, const int64_t num_samples,
+                  mt19937 &generator) {
+  auto &touched = state->touched;
+  if ((int64_t)touched.size() > num_samples) {
+    uniform_real_distribution<double> dist(0., 1.);
+    vector<pair<double, int64_t>> keys(touched.size());
+    for (int64_t i = 0; i < (int64_t)touched.size(); i++) {
+      const auto &v = touched[i];
+      const double weight = double(state->budget(v)) * state->budget(v);
+      keys[i] = {log(1. - dist(generator)) / weight, v};
+    }
+    nth_element(keys.begin(), keys.begin() + num_samples, keys.end(),
+                greater<pair<double, int64_t>>());
+    for (int64_t i = 0; i < num_samples; i++)
+      touched[i] = keys[i].second;
   }
 
-  const auto weight = from_vector(weights, true);
-  const auto sample = choice(budget.size(), num_samples, false, weight);
-  const auto *sample_data = sample.data_ptr<int64_t>();
-
-  vector<int64_t> out(sample.numel());
-  for (int64_t i = 0; i < sample.numel(); i++) {
-    out[i] = indices[sample_data[i]];
+  const auto size = min(num_samples, (int64_t)touched.size());
+  for (int64_t i = 0; i < size; i++) {
+    const auto &v = touched[i];
+    state->add_node(v);
+    state->erase_budget(v);
   }
-  return out;
+  touched.erase(remove_if(touched.begin(), touched.end(),
+                          [&](const int64_t &v) {
+                            return state->to_local(v) >= 0;
+                          }),
+                touched.end());
 }
 
 tuple<c10::Dict<node_t, torch::Tensor>, c10::Dict<rel_t, torch::Tensor>,
@@ -105,81 +184,81 @@ hgt_sample_cpu(const c10::Dict<rel_t, torch::Tensor> &colptr_dict,
                const c10::Dict<node_t, vector<int64_t>> &num_samples_dict,
                const int64_t num_hops) {
 
-  srand(time(NULL) + 1000 * getpid()); // Initialize random seed.
+  // Assign indices to node types, and collect relations among them:
+  vector<node_t> node_types;
+  unordered_map<node_t, int64_t> to_node_type;
+  for (const auto &kv : num_samples_dict) {
+    to_node_type[kv.key()] = node_types.size();
+    node_types.push_back(kv.key());
+  }
+  const int64_t num_node_types = node_types.size();
 
-  // Create a mapping to convert single string relations to edge type triplets:
-  unordered_map<rel_t, edge_t> to_edge_type;
+  vector<Relation> relations;
   for (const auto &kv : colptr_dict) {
     const auto &rel_type = kv.key();
-    to_edge_type[rel_type] = split(rel_type);
+    const auto edge_type = split(rel_type);
+    relations.push_back({rel_type, to_node_type.at(get<0>(edge_type)),
+                         to_node_type.at(get<2>(edge_type)),
+                         kv.value().data_ptr<int64_t>(),
+                         row_dict.at(rel_type).data_ptr<int64_t>()});
   }
 
-  // Initialize some necessary data structures for the sampling process:
-  unordered_map<node_t, vector<int64_t>> nodes_dict;
-  unordered_map<node_t, unordered_map<int64_t, int64_t>> to_local_node_dict;
-  unordered_map<node_t, unordered_map<int64_t, float>> budget_dict;
-  for (const auto &kv : num_samples_dict) {
-    const auto &node_type = kv.key();
-    nodes_dict[node_type];
-    to_local_node_dict[node_type];
-    budget_dict[node_type];
+  // Determine the number of nodes of every node type that is a destination
+  // of some relation. Source-only node types are left unknown (`-1`):
+  vector<int64_t> num_nodes(num_node_types, -1);
+  for (const auto &relation : relations) {
+    const auto &colptr = colptr_dict.at(relation.rel_type);
+    num_nodes[relation.dst] =
+        max(num_nodes[relation.dst], colptr.numel() - 1);
   }
+  for (const auto &kv : input_node_dict) {
+    const auto &input_node = kv.value();
+    auto &n = num_nodes[to_node_type.at(kv.key())];
+    if (n >= 0 && input_node.numel() > 0)
+      n = max(n, input_node.max().item<int64_t>() + 1);
+  }
+
+  // Initialize some necessary data structures for the sampling process:
+  vector<NodeState> states(num_node_types);
+  for (int64_t t = 0; t < num_node_types; t++)
+    states[t].init(num_nodes[t]);
+
+  random_device seed; // Initialize random seeds.
+  vector<mt19937> generators;
+  for (int64_t t = 0; t < max(num_node_types, (int64_t)relations.size()); t++)
+    generators.emplace_back(seed());
 
   // Add the input nodes to the sampled output nodes (line 1):
   for (const auto &kv : input_node_dict) {
-    const auto &node_type = kv.key();
     const auto &input_node = kv.value();
     const auto *input_node_data = input_node.data_ptr<int64_t>();
 
-    auto &nodes = nodes_dict.at(node_type);
-    auto &to_local_node = to_local_node_dict.at(node_type);
-    for (int64_t i = 0; i < input_node.numel(); i++) {
-      const auto &v = input_node_data[i];
-      nodes.push_back(v);
-      to_local_node[v] = i;
-    }
+    auto &state = states[to_node_type.at(kv.key())];
+    for (int64_t i = 0; i < input_node.numel(); i++)
+      state.add_node(input_node_data[i]);
   }
 
   // Update the budget based on the initial input set (line 3-5):
-  for (const auto &kv : nodes_dict) {
-    const auto &node_type = kv.first;
-    const auto &last_samples = kv.second;
-    update_budget_(&budget_dict, node_type, last_samples, to_local_node_dict,
-                   to_edge_type, colptr_dict, row_dict);
-  }
+  vector<int64_t> begin(num_node_types, 0);
+  update_budget_(&states, relations, begin, &generators);
 
   for (int64_t ell = 0; ell < num_hops; ell++) {
-    unordered_map<node_t, vector<int64_t>> samples_dict;
-    for (auto &kv : budget_dict) {
-      const auto &node_type = kv.first;
-      auto &budget = kv.second;
-      const auto num_samples = num_samples_dict.at(node_type)[ell];
-
-      // Sample `num_samples` nodes, according to the budget (line 9-11):
-      const auto samples = sample_from(budget, num_samples);
-      samples_dict[node_type] = samples;
-
-      // Add samples to the sampled output nodes, and erase them from the budget
-      // (line 13/15):
-      auto &nodes = nodes_dict.at(node_type);
-      auto &to_local_node = to_local_node_dict.at(node_type);
-      for (const auto &v : samples) {
-        to_local_node[v] = nodes.size();
-        nodes.push_back(v);
-        budget.erase(v);
+    for (int64_t t = 0; t < num_node_types; t++)
+      begin[t] = states[t].nodes.size();
+
+    // Sample `num_samples` nodes, according to the budget, add them to the
+    // sampled output nodes, and erase them from the budget (line 9-15):
+    at::parallel_for(0, num_node_types, 1, [&](int64_t b, int64_t e) {
+      for (int64_t t = b; t < e; t++) {
+        const auto num_samples = num_samples_dict.at(node_types[t])[ell];
+        sample_from_(&states[t], num_samples, generators[t]);
       }
-    }
+    });
 
-    if (ell < num_hops - 1) {
-      // Add neighbors of newly sampled nodes to the budget (line 14):
-      // Note that we do not need to update the budget in the last iteration.
-      for (const auto &kv : samples_dict) {
-        const auto &node_type = kv.first;
-        const auto &last_samples = kv.second;
-        update_budget_(&budget_dict, node_type, last_samples,
-                       to_local_node_dict, to_edge_type, colptr_dict, row_dict);
-      }
-    }
+    // Add neighbors of newly sampled nodes to the budget (line 14):
+    // Note that we do not need to update the budget in the last iteration.
+    if (ell < num_hops - 1)
+      update_budget_(&states, relations, begin, &generators);
   }
 
   c10::Dict<node_t, torch::Tensor> out_node_dict;
@@ -188,57 +267,52 @@ hgt_sample_cpu(const c10::Dict<rel_t, torch::Tensor> &colptr_dict,
   c10::Dict<rel_t, torch::Tensor> out_edge_dict;
 
   // Reconstruct the sampled adjacency matrix among the sampled nodes (line 19):
-  for (const auto &kv : colptr_dict) {
-    const auto &rel_type = kv.key();
-    const auto &edge_type = to_edge_type.at(rel_type);
-    const auto &src_node_type = get<0>(edge_type);
-    const auto &dst_node_type = get<2>(edge_type);
-
-    const auto *colptr_data = kv.value().data_ptr<int64_t>();
-    const auto *row_data = row_dict.at(rel_type).data_ptr<int64_t>();
-
-    const auto &dst_nodes = nodes_dict.at(dst_node_type);
-    const auto &to_local_src_node = to_local_node_dict.at(src_node_type);
-
-    vector<int64_t> rows, cols, edges;
-    for (int64_t i = 0; i < (int64_t)dst_nodes.size(); i++) {
-      const auto &w = dst_nodes[i];
-      const auto &col_start = colptr_data[w], &col_end = colptr_data[w + 1];
-      if (col_end - col_start > MAX_NEIGHBORS) {
-        auto indices = choice(col_end - col_start, MAX_NEIGHBORS, false);
-        auto *indices_data = indices.data_ptr<int64_t>();
-        for (int64_t j = 0; j < indices.numel(); j++) {
-          const auto &v = row_data[col_start + indices_data[j]];
-          if (to_local_src_node.find(v) != to_local_src_node.end()) {
-            rows.push_back(to_local_src_node.at(v));
-            cols.push_back(i);
-            edges.push_back(col_start + j);
-          }
-        }
-      } else {
-        for (int64_t j = col_start; j < col_end; j++) {
-          const auto &v = row_data[j];
-          if (to_local_src_node.find(v) != to_local_src_node.end()) {
-            rows.push_back(to_local_src_node.at(v));
-            cols.push_back(i);
-            edges.push_back(j);
+  const int64_t num_relations = relations.size();
+  vector<vector<int64_t>> rows(num_relations), cols(num_relations),
+      edges(num_relations);
+  at::parallel_for(0, num_relations, 1, [&](int64_t b, int64_t e) {
+    int64_t indices[MAX_NEIGHBORS];
+    for (int64_t r = b; r < e; r++) {
+      const auto &relation = relations[r];
+      const auto *colptr_data = relation.colptr_data;
+      const auto *row_data = relation.row_data;
+      const auto &dst_nodes = states[relation.dst].nodes;
+      const auto &src_state = states[relation.src];
+
+      for (int64_t i = 0; i < (int64_t)dst_nodes.size(); i++) {
+        const auto &w = dst_nodes[i];
+        const auto &col_start = colptr_data[w], &col_end = colptr_data[w + 1];
+        const auto col_count = col_end - col_start;
+        const bool subsample = col_count > MAX_NEIGHBORS;
+        if (subsample)
+          draw_neighbors(col_count, generators[r], indices);
+        for (int64_t j = 0; j < (subsample ? MAX_NEIGHBORS : col_count); j++) {
+          const auto offset = col_start + (subsample ? indices[j] : j);
+          const auto u = src_state.to_local(row_data[offset]);
+          if (u >= 0) {
+            rows[r].push_back(u);
+            cols[r].push_back(i);
+            edges[r].push_back(offset);
           }
         }
       }
     }
-    if (rows.size() > 0) {
-      out_row_dict.insert(rel_type, from_vector<int64_t>(rows));
-      out_col_dict.insert(rel_type, from_vector<int64_t>(cols));
-      out_edge_dict.insert(rel_type, from_vector<int64_t>(edges));
+  });
+
+  for (int64_t r = 0; r < num_relations; r++) {
+    if (rows[r].size() > 0) {
+      const auto &rel_type = relations[r].rel_type;
+      out_row_dict.insert(rel_type, from_vector<int64_t>(rows[r]));
+      out_col_dict.insert(rel_type, from_vector<int64_t>(cols[r]));
+      out_edge_dict.insert(rel_type, from_vector<int64_t>(edges[r]));
     }
   }
 
   // Generate tensor-valued output node dictionary (line 20):
-  for (const auto &kv : nodes_dict) {
-    const auto &node_type = kv.first;
-    const auto &nodes = kv.second;
+  for (int64_t t = 0; t < num_node_types; t++) {
+    const auto &nodes = states[t].nodes;
     if (!nodes.empty())
-      out_node_dict.insert(node_type, from_vector<int64_t>(nodes));
+      out_node_dict.insert(node_types[t], from_vector<int64_t>(nodes));
   }
 
   return make_tuple(out_node_dict, out_row_dict, out_col_dict, out_edge_dict);
@@ -0,0 +1,156 @@
+#include "index_select_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+// Selects the rows `idx` of a CSR matrix via a counting pass followed by a
+// parallel fill. Returns the output pattern and the permutation `perm` into
+// the input entries, so that values can be gathered afterwards.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_row_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::Tensor idx) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(idx);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(idx.dim() == 1);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+  idx = idx.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto idx_data = idx.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+  auto K = idx.numel();
+
+  auto out_rowptr = torch::empty(K + 1, rowptr.options());
+  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+  out_rowptr_data[0] = 0;
+  int64_t i, r;
+  for (i = 0; i < K; i++) {
+    r = idx_data[i];
+    if (r < 0 || r >= M)
+      AT_ERROR("Row index ", r, " out of range for size ", M);
+    out_rowptr_data[i + 1] =
+        out_rowptr_data[i] + rowptr_data[r + 1] - rowptr_data[r];
+  }
+
+  auto E = out_rowptr_data[K];
+  auto out_col = torch::empty(E, col.options());
+  auto perm = torch::empty(E, col.options());
+  auto out_col_data = out_col.data_ptr<int64_t>();
+  auto perm_data = perm.data_ptr<int64_t>();
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(E / std::max(K, (int64_t)1), (int64_t)1);
+  at::parallel_for(0, K, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t row_start, offset;
+    for (auto i = begin; i < end; i++) {
+      row_start = rowptr_data[idx_data[i]], offset = out_rowptr_data[i];
+      for (int64_t j = 0; j < out_rowptr_data[i + 1] - offset; j++) {
+        out_col_data[offset + j] = col_data[row_start + j];
+        perm_data[offset + j] = row_start + j;
+      }
+    }
+  });
+
+  return std::make_tuple(out_rowptr, out_col, perm);
+}
+
+// Selects the columns `idx` of a CSR matrix without converting it to CSC:
+// Old columns are mapped to (possibly multiple) new columns, which are
+// written row by row via a counting pass followed by a parallel fill.
+// Rows only need to be re-sorted in case `idx` is not strictly increasing.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_col_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::Tensor idx, int64_t N) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(idx);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(idx.dim() == 1);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+  idx = idx.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto idx_data = idx.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+  auto K = idx.numel();
+
+  // Map every old column `c` to its new columns `map[mapptr[c]:mapptr[c+1]]`:
+  std::vector<int64_t> mapptr(N + 1, 0), map(K);
+  bool sorted = true;
+  int64_t i, c;
+  for (i = 0; i < K; i++) {
+    c = idx_data[i];
+    if (c < 0 || c >= N)
+      AT_ERROR("Column index ", c, " out of range for size ", N);
+    mapptr[c + 1]++;
+    sorted = sorted && (i == 0 || idx_data[i - 1] < c);
+  }
+  for (c = 0; c < N; c++)
+    mapptr[c + 1] += mapptr[c];
+  std::vector<int64_t> cursor(mapptr.begin(), mapptr.end() - 1);
+  for (i = 0; i < K; i++)
+    map[cursor[idx_data[i]]++] = i;
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(col.numel() / std::max(M, (int64_t)1),
+                                (int64_t)1);
+
+  auto out_rowptr = torch::zeros(M + 1, rowptr.options());
+  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t count;
+    for (auto m = begin; m < end; m++) {
+      count = 0;
+      for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++)
+        count += mapptr[col_data[e] + 1] - mapptr[col_data[e]];
+      out_rowptr_data[m + 1] = count;
+    }
+  });
+  out_rowptr = out_rowptr.cumsum(0);
+  out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+
+  auto E = out_rowptr_data[M];
+  auto out_col = torch::empty(E, col.options());
+  auto perm = torch::empty(E, col.options());
+  auto out_col_data = out_col.data_ptr<int64_t>();
+  auto perm_data = perm.data_ptr<int64_t>();
+
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int64_t, int64_t>> buffer;
+    int64_t offset;
+    for (auto m = begin; m < end; m++) {
+      offset = out_rowptr_data[m];
+      for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+        for (auto p = mapptr[col_data[e]]; p < mapptr[col_data[e] + 1]; p++) {
+          out_col_data[offset] = map[p];
+          perm_data[offset] = e;
+          offset++;
+        }
+      }
+
+      if (!sorted) {
+        buffer.clear();
+        for (auto j = out_rowptr_data[m]; j < offset; j++)
+          buffer.push_back(std::make_pair(out_col_data[j], perm_data[j]));
+        std::sort(buffer.begin(), buffer.end());
+        for (auto j = out_rowptr_data[m]; j < offset; j++) {
+          out_col_data[j] = buffer[j - out_rowptr_data[m]].first;
+          perm_data[j] = buffer[j - out_rowptr_data[m]].second;
+        }
+      }
+    }
+  });
+
+  return std::make_tuple(out_rowptr, out_col, perm);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_row_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::Tensor idx);
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_col_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::Tensor idx, int64_t N);
@@ -0,0 +1,130 @@
+#include "ladies_sample_cpu.h"
+
+#include <random>
+
+#include "utils.h"
+
+using namespace std;
+
+// Layer-wise importance sampling (LADIES): Every layer samples a fixed number
+// of nodes from the union of the neighborhoods of the previous layer, with
+// probabilities proportional to the squared column norms of the adjacency
+// restricted to the previous layer. Layers are connected by bipartite blocks,
+// whose edges are re-weighted by `1 / (layer_size * probability)`.
+// Returns the nodes of every layer `node[node_ptr[l]:node_ptr[l + 1]]`, and
+// the CSR blocks `rowptr`, `col`, `edge`, `weight` from layer `l` to layer
+// `l + 1`, in which `col` holds indices into the nodes of layer `l + 1`.
+tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+      torch::Tensor, torch::Tensor>
+ladies_sample_cpu(torch::Tensor colptr, torch::Tensor row,
+                  torch::optional<torch::Tensor> optional_value,
+                  torch::Tensor input_node, vector<int64_t> layer_sizes) {
+  CHECK_CPU(colptr);
+  CHECK_CPU(row);
+  CHECK_CPU(input_node);
+  CHECK_INPUT(colptr.dim() == 1);
+  CHECK_INPUT(row.dim() == 1);
+  CHECK_INPUT(input_node.dim() == 1);
+
+  torch::Tensor value;
+  if (optional_value.has_value()) {
+    value = optional_value.value().to(torch::kDouble);
+    CHECK_CPU(value);
+    CHECK_INPUT(value.numel() == row.numel());
+  }
+
+  mt19937 generator(random_device{}()); // Initialize random seed.
+
+  colptr = colptr.contiguous(), row = row.contiguous();
+  input_node = input_node.contiguous();
+
+  const auto *colptr_data = colptr.data_ptr<int64_t>();
+  const auto *row_data = row.data_ptr<int64_t>();
+  const auto *input_node_data = input_node.data_ptr<int64_t>();
+  const double *value_data = value.defined() ? value.data_ptr<double>() : NULL;
+
+  vector<int64_t> nodes(input_node_data, input_node_data + input_node.numel());
+  vector<int64_t> node_ptr = {0, (int64_t)nodes.size()};
+  vector<int64_t> rowptr = {0};
+  vector<int64_t> cols, edges;
+  vector<double> weights;
+
+  for (const auto &layer_size : layer_sizes) {
+    const auto begin = node_ptr[node_ptr.size() - 2];
+    const auto end = node_ptr[node_ptr.size() - 1];
+
+    // Compute the importance of every node in the union of neighborhoods:
+    vector<int64_t> candidates;
+    unordered_map<int64_t, double> importance;
+    for (int64_t i = begin; i < end; i++) {
+      const auto &w = nodes[i];
+      for (int64_t e = colptr_data[w]; e < colptr_data[w + 1]; e++) {
+        const auto a = value_data ? value_data[e] : 1.;
+        const auto res = importance.insert({row_data[e], 0.});
+        if (res.second)
+          candidates.push_back(row_data[e]);
+        res.first->second += a * a;
+      }
+    }
+
+    double total = 0.;
+    for (const auto &kv : importance)
+      total += kv.second;
+
+    // Sample `layer_size` nodes without replacement via Efraimidis-Spirakis
+    // keys, or keep all candidates in case there are not enough of them:
+    const bool subsample =
+        layer_size >= 0 && (int64_t)candidates.size() > layer_size;
+    if (subsample) {
+      uniform_real_distribution<double> dist(0., 1.);
+      vector<pair<double, int64_t>> keys;
+      keys.reserve(candidates.size());
+      for (const auto &v : candidates) {
+        const auto weight = importance.at(v);
+        if (weight > 0.)
+          keys.push_back({log(1. - dist(generator)) / weight, v});
+      }
+      const auto size = min(layer_size, (int64_t)keys.size());
+      nth_element(keys.begin(), keys.begin() + size, keys.end(),
+                  greater<pair<double, int64_t>>());
+      candidates.resize(size);
+      for (int64_t k = 0; k < size; k++)
+        candidates[k] = keys[k].second;
+    }
+    sort(candidates.begin(), candidates.end());
+
+    unordered_map<int64_t, int64_t> to_local_node;
+    for (int64_t k = 0; k < (int64_t)candidates.size(); k++)
+      to_local_node[candidates[k]] = k;
+
+    // Connect the previous layer to the sampled nodes:
+    for (int64_t i = begin; i < end; i++) {
+      const auto &w = nodes[i];
+      for (int64_t e = colptr_data[w]; e < colptr_data[w + 1]; e++) {
+        const auto iter = to_local_node.find(row_data[e]);
+        if (iter == to_local_node.end())
+          continue;
+        auto weight = value_data ? value_data[e] : 1.;
+        if (subsample)
+          weight *= total / (layer_size * importance.at(row_data[e]));
+        cols.push_back(iter->second);
+        edges.push_back(e);
+        weights.push_back(weight);
+      }
+      rowptr.push_back(cols.size());
+    }
+
+    nodes.insert(nodes.end(), candidates.begin(), candidates.end());
+    node_ptr.push_back(nodes.size());
+  }
+
+  auto weight = from_vector<double>(weights);
+  if (optional_value.has_value())
+    weight = weight.to(optional_value.value().scalar_type());
+  else
+    weight = weight.to(torch::kFloat);
+
+  return make_tuple(from_vector<int64_t>(nodes), from_vector<int64_t>(node_ptr),
+                    from_vector<int64_t>(rowptr), from_vector<int64_t>(cols),
+                    from_vector<int64_t>(edges), weight);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+           torch::Tensor, torch::Tensor>
+ladies_sample_cpu(torch::Tensor colptr, torch::Tensor row,
+                  torch::optional<torch::Tensor> optional_value,
+                  torch::Tensor input_node, std::vector<int64_t> layer_sizes);
@@ -1,5 +1,9 @@
 #include "metis_cpu.h"
 
+#include <atomic>
+#include <cmath>
+#include <thread>
+
 #ifdef WITH_METIS
 #include <metis.h>
 #endif
@@ -118,3 +122,233 @@ mt_partition_cpu(torch::Tensor rowptr, torch::Tensor col,
   AT_ERROR("Not compiled with MTMETIS support");
 #endif
 }
+
+// Number of nodes a worker claims at once from the node stream:
+#define STREAM_CHUNK_SIZE 1024
+
+// Streaming partitioning via Linear Deterministic Greedy (LDG) or Fennel,
+// which visits every node once in order and assigns it to the partition that
+// holds most of its (weighted) neighbors, penalized by the partition size.
+// Only the current assignment and partition sizes are kept in memory, so
+// that `rowptr` and `col` can be memory-mapped and get read sequentially.
+// `num_workers` threads consume chunks of the node stream concurrently, and
+// see the assignments of each other as they happen.
+torch::Tensor
+stream_partition_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::optional<torch::Tensor> optional_value,
+                     torch::optional<torch::Tensor> optional_node_weight,
+                     int64_t num_parts, bool fennel, int64_t num_workers) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_INPUT(num_parts >= 1);
+
+  torch::Tensor value, node_weight;
+  if (optional_value.has_value()) {
+    CHECK_CPU(optional_value.value());
+    CHECK_INPUT(optional_value.value().dim() == 1);
+    CHECK_INPUT(optional_value.value().numel() == col.numel());
+    value = optional_value.value().to(torch::kDouble);
+  }
+
+  if (optional_node_weight.has_value()) {
+    CHECK_CPU(optional_node_weight.value());
+    CHECK_INPUT(optional_node_weight.value().dim() == 1);
+    CHECK_INPUT(optional_node_weight.value().numel() == rowptr.numel() - 1);
+    node_weight = optional_node_weight.value().to(torch::kLong);
+  }
+
+  const auto N = rowptr.numel() - 1;
+  const auto E = col.numel();
+  const auto *rowptr_data = rowptr.data_ptr<int64_t>();
+  const auto *col_data = col.data_ptr<int64_t>();
+  const double *value_data = value.defined() ? value.data_ptr<double>() : NULL;
+  const int64_t *node_weight_data =
+      node_weight.defined() ? node_weight.data_ptr<int64_t>() : NULL;
+
+  const int64_t total_weight =
+      node_weight.defined() ? node_weight.sum().item<int64_t>() : N;
+
+  // Partitions may exceed their balanced size by at most 10%:
+  const double capacity = 1.1 * double(total_weight) / num_parts + 1.;
+
+  // Fennel penalizes partition sizes via `alpha * gamma * size^(gamma - 1)`:
+  const double gamma = 1.5;
+  const double alpha = std::sqrt(double(num_parts)) * double(E) /
+                       std::pow(std::max(double(total_weight), 1.), gamma);
+
+  std::vector<std::atomic<int64_t>> part(N);
+  for (auto &p : part)
+    p.store(-1, std::memory_order_relaxed);
+  std::vector<std::atomic<int64_t>> part_size(num_parts);
+  for (auto &size : part_size)
+    size.store(0, std::memory_order_relaxed);
+
+  std::atomic<int64_t> next_chunk(0);
+  auto work = [&] {
+    std::vector<double> score(num_parts, 0.);
+    std::vector<int64_t> touched;
+    while (true) {
+      const auto begin = next_chunk++ * STREAM_CHUNK_SIZE;
+      if (begin >= N)
+        return;
+      const auto end = std::min(begin + STREAM_CHUNK_SIZE, N);
+      for (auto v = begin; v < end; v++) {
+        const auto w = node_weight_data ? node_weight_data[v] : 1;
+
+        // Accumulate the weight of already assigned neighbors per partition:
+        for (auto e = rowptr_data[v]; e < rowptr_data[v + 1]; e++) {
+          const auto p = part[col_data[e]].load(std::memory_order_relaxed);
+          if (p < 0)
+            continue;
+          if (score[p] == 0.)
+            touched.push_back(p);
+          score[p] += value_data ? value_data[e] : 1.;
+        }
+
+        int64_t best = -1;
+        double best_score = 0.;
+        int64_t best_size = 0;
+        for (int64_t p = 0; p < num_parts; p++) {
+          const auto size = part_size[p].load(std::memory_order_relaxed);
+          if (size + w > capacity)
+            continue;
+          double s;
+          if (fennel)
+            s = score[p] - alpha * gamma * std::sqrt(double(size)) * w;
+          else
+            s = score[p] * (1. - double(size) / capacity);
+          // Break ties in favor of smaller partitions:
+          if (best < 0 || s > best_score ||
+              (s == best_score && size < best_size))
+            best = p, best_score = s, best_size = size;
+        }
+
+        // All partitions are full, so fall back to the smallest one:
+        if (best < 0) {
+          for (int64_t p = 0; p < num_parts; p++) {
+            const auto size = part_size[p].load(std::memory_order_relaxed);
+            if (best < 0 || size < best_size)
+              best = p, best_size = size;
+          }
+        }
+
+        part[v].store(best, std::memory_order_relaxed);
+        part_size[best].fetch_add(w, std::memory_order_relaxed);
+
+        for (const auto &p : touched)
+          score[p] = 0.;
+        touched.clear();
+      }
+    }
+  };
+
+  if (num_workers <= 0)
+    num_workers = at::get_num_threads();
+  std::vector<std::thread> workers;
+  for (int64_t t = 1; t < num_workers; t++)
+    workers.emplace_back(work);
+  work();
+  for (auto &worker : workers)
+    worker.join();
+
+  auto out = torch::empty(N, rowptr.options());
+  auto out_data = out.data_ptr<int64_t>();
+  for (int64_t v = 0; v < N; v++)
+    out_data[v] = part[v].load(std::memory_order_relaxed);
+  return out;
+}
+
+// Extracts the subgraph induced by the union of the clusters `cluster` of a
+// graph whose nodes are permuted contiguously by cluster, i.e., cluster `c`
+// holds the nodes `[partptr[c], partptr[c + 1])`. Selected clusters get
+// concatenated in the given order, so that membership and relabeling reduce
+// to a range check and an offset.
+// Returns `node`, `rowptr`, `col`, `e_id`
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+cluster_subgraph_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::Tensor partptr, torch::Tensor cluster) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(partptr);
+  CHECK_CPU(cluster);
+  CHECK_INPUT(partptr.dim() == 1);
+  CHECK_INPUT(cluster.dim() == 1);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+  partptr = partptr.contiguous(), cluster = cluster.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto partptr_data = partptr.data_ptr<int64_t>();
+  auto cluster_data = cluster.data_ptr<int64_t>();
+  auto P = partptr.numel() - 1;
+
+  // Output offset of every selected cluster, or -1 otherwise:
+  std::vector<int64_t> offset(P, -1);
+  int64_t N = 0;
+  for (int64_t k = 0; k < cluster.numel(); k++) {
+    const auto c = cluster_data[k];
+    CHECK_INPUT(c >= 0 && c < P);
+    CHECK_INPUT(offset[c] == -1);
+    offset[c] = N;
+    N += partptr_data[c + 1] - partptr_data[c];
+  }
+
+  auto node = torch::empty(N, rowptr.options());
+  auto node_data = node.data_ptr<int64_t>();
+  for (int64_t k = 0; k < cluster.numel(); k++) {
+    const auto c = cluster_data[k];
+    for (int64_t v = partptr_data[c]; v < partptr_data[c + 1]; v++)
+      node_data[offset[c] + v - partptr_data[c]] = v;
+  }
+
+  // Maps `v` to its local index, or to -1 if its cluster is not selected:
+  auto to_local = [&](int64_t v) -> int64_t {
+    const auto c = std::upper_bound(partptr_data, partptr_data + P + 1, v) -
+                   partptr_data - 1;
+    if (c < 0 || c >= P || offset[c] < 0)
+      return -1;
+    return offset[c] + v - partptr_data[c];
+  };
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(col.numel() / std::max(rowptr.numel() - 1,
+                                                       (int64_t)1),
+                                (int64_t)1);
+
+  auto out_rowptr = torch::zeros(N + 1, rowptr.options());
+  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+  at::parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t v, count;
+    for (auto i = begin; i < end; i++) {
+      v = node_data[i], count = 0;
+      for (auto e = rowptr_data[v]; e < rowptr_data[v + 1]; e++)
+        count += to_local(col_data[e]) >= 0;
+      out_rowptr_data[i + 1] = count;
+    }
+  });
+  out_rowptr = out_rowptr.cumsum(0);
+  out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+
+  auto E = out_rowptr_data[N];
+  auto out_col = torch::empty(E, col.options());
+  auto out_col_data = out_col.data_ptr<int64_t>();
+  auto out_e_id = torch::empty(E, col.options());
+  auto out_e_id_data = out_e_id.data_ptr<int64_t>();
+  at::parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t v, u, offset;
+    for (auto i = begin; i < end; i++) {
+      v = node_data[i], offset = out_rowptr_data[i];
+      for (auto e = rowptr_data[v]; e < rowptr_data[v + 1]; e++) {
+        u = to_local(col_data[e]);
+        if (u >= 0) {
+          out_col_data[offset] = u;
+          out_e_id_data[offset] = e;
+          offset++;
+        }
+      }
+    }
+  });
+
+  return std::make_tuple(node, out_rowptr, out_col, out_e_id);
+}
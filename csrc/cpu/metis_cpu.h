@@ -12,3 +12,13 @@ mt_partition_cpu(torch::Tensor rowptr, torch::Tensor col,
                  torch::optional<torch::Tensor> optional_value,
                  torch::optional<torch::Tensor> optional_node_weight,
                  int64_t num_parts, bool recursive, int64_t num_workers);
+
+torch::Tensor
+stream_partition_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::optional<torch::Tensor> optional_value,
+                     torch::optional<torch::Tensor> optional_node_weight,
+                     int64_t num_parts, bool fennel, int64_t num_workers);
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+cluster_subgraph_cpu(torch::Tensor rowptr, torch::Tensor col,
+                     torch::Tensor partptr, torch::Tensor cluster);
@@ -0,0 +1,305 @@
+#include "mmap_cpu.h"
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "utils.h"
+
+// Binary CSR format, stored in native byte order: A fixed-size header is
+// followed by the `rowptr`, `col`, `value`, `colptr`, `csr2csc`, `row`,
+// `rowcount`, `colcount` and `csc2csr` sections in this order. Every section
+// starts at an offset aligned to `CSR_ALIGNMENT` bytes, so that it can be
+// memory-mapped and wrapped as a tensor without copying. Missing sections
+// are marked by `dim == 0`.
+static const char CSR_MAGIC[8] = {'T', 'S', 'P', 'C', 'S', 'R', '\0', '\0'};
+static const int64_t CSR_VERSION = 2;
+static const int64_t CSR_ALIGNMENT = 64;
+static const int64_t CSR_NUM_SECTIONS = 9;
+static const int64_t CSR_MAX_DIM = 4;
+
+struct CSRSection {
+  int64_t offset;
+  int64_t dtype; // `c10::ScalarType`.
+  int64_t dim;
+  int64_t sizes[CSR_MAX_DIM];
+};
+
+struct CSRHeader {
+  char magic[8];
+  int64_t version;
+  int64_t num_rows;
+  int64_t num_cols;
+  CSRSection sections[CSR_NUM_SECTIONS];
+};
+
+inline int64_t align(int64_t offset) {
+  return (offset + CSR_ALIGNMENT - 1) / CSR_ALIGNMENT * CSR_ALIGNMENT;
+}
+
+inline int64_t nbytes(const torch::Tensor &tensor) {
+  return tensor.numel() * tensor.element_size();
+}
+
+// Fills in the header for the given sections and returns the total size of
+// the serialized matrix in bytes:
+static int64_t
+make_header(std::vector<torch::optional<torch::Tensor>> &tensors,
+            int64_t num_rows, int64_t num_cols, CSRHeader *header) {
+  std::memset(header, 0, sizeof(CSRHeader));
+  std::memcpy(header->magic, CSR_MAGIC, sizeof(CSR_MAGIC));
+  header->version = CSR_VERSION;
+  header->num_rows = num_rows;
+  header->num_cols = num_cols;
+
+  int64_t offset = align(sizeof(CSRHeader));
+  for (int64_t i = 0; i < CSR_NUM_SECTIONS; i++) {
+    if (!tensors[i].has_value())
+      continue;
+
+    auto tensor = tensors[i].value().contiguous();
+    CHECK_CPU(tensor);
+    CHECK_INPUT(tensor.dim() >= 1 && tensor.dim() <= CSR_MAX_DIM);
+    tensors[i] = tensor;
+
+    auto &section = header->sections[i];
+    section.offset = offset;
+    section.dtype = (int64_t)tensor.scalar_type();
+    section.dim = tensor.dim();
+    for (int64_t d = 0; d < tensor.dim(); d++)
+      section.sizes[d] = tensor.size(d);
+    offset = align(offset + nbytes(tensor));
+  }
+  return offset;
+}
+
+void csr_save_cpu(std::string path, torch::Tensor rowptr, torch::Tensor col,
+                  torch::optional<torch::Tensor> optional_value,
+                  torch::optional<torch::Tensor> optional_colptr,
+                  torch::optional<torch::Tensor> optional_csr2csc,
+                  torch::optional<torch::Tensor> optional_row,
+                  torch::optional<torch::Tensor> optional_rowcount,
+                  torch::optional<torch::Tensor> optional_colcount,
+                  torch::optional<torch::Tensor> optional_csc2csr,
+                  int64_t num_rows, int64_t num_cols) {
+  std::vector<torch::optional<torch::Tensor>> tensors = {
+      rowptr, col, optional_value, optional_colptr, optional_csr2csc,
+      optional_row, optional_rowcount, optional_colcount, optional_csc2csr};
+
+  CSRHeader header;
+  make_header(tensors, num_rows, num_cols, &header);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    AT_ERROR("Could not open '", path, "' for writing");
+
+  std::vector<char> padding(CSR_ALIGNMENT, 0);
+  out.write((const char *)&header, sizeof(CSRHeader));
+  int64_t pos = sizeof(CSRHeader);
+  for (int64_t i = 0; i < CSR_NUM_SECTIONS; i++) {
+    if (!tensors[i].has_value())
+      continue;
+
+    auto tensor = tensors[i].value();
+    out.write(padding.data(), header.sections[i].offset - pos);
+    out.write((const char *)tensor.data_ptr(), nbytes(tensor));
+    pos = header.sections[i].offset + nbytes(tensor);
+  }
+
+  if (!out)
+    AT_ERROR("Could not write to '", path, "'");
+}
+
+#ifndef _WIN32
+// Memory-maps the serialized matrix behind `fd` and wraps its sections as
+// tensors. The mapping is private and writable, i.e., pages get shared via
+// the page cache across processes and are only copied once they get written
+// to. The mapping is released as soon as all returned tensors got freed.
+static csr_sections_t map_sections(int fd, const std::string &name) {
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(CSRHeader)) {
+    close(fd);
+    AT_ERROR("'", name, "' is not a valid CSR file");
+  }
+
+  int64_t size = st.st_size;
+  auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED)
+    AT_ERROR("Could not memory-map '", name, "'");
+
+  std::shared_ptr<void> mapping(ptr, [size](void *p) { munmap(p, size); });
+
+  auto header = (const CSRHeader *)ptr;
+  if (std::memcmp(header->magic, CSR_MAGIC, sizeof(CSR_MAGIC)) != 0)
+    AT_ERROR("'", name, "' is not a valid CSR file");
+  if (header->version != CSR_VERSION)
+    AT_ERROR("Unsupported CSR file version ", header->version);
+
+  // The returned tensors are trusted by all kernels, so that every header
+  // field needs to be validated before wrapping any section:
+  if (header->num_rows < 0 || header->num_cols < 0)
+    AT_ERROR("'", name, "' has a corrupt header");
+
+  std::vector<torch::optional<torch::Tensor>> tensors(CSR_NUM_SECTIONS);
+  for (int64_t i = 0; i < CSR_NUM_SECTIONS; i++) {
+    auto &section = header->sections[i];
+    if (section.dim == 0)
+      continue;
+    if (section.dim < 0 || section.dim > CSR_MAX_DIM ||
+        section.offset < (int64_t)sizeof(CSRHeader) ||
+        section.offset % CSR_ALIGNMENT != 0 || section.offset > size ||
+        section.dtype < 0 ||
+        section.dtype >= (int64_t)at::ScalarType::NumOptions)
+      AT_ERROR("'", name, "' has a corrupt header");
+
+    // Bound the number of elements by the bytes left in the file, which
+    // rules out overflows when multiplying sizes:
+    auto dtype = (at::ScalarType)section.dtype;
+    int64_t numel = 1;
+    const int64_t capacity =
+        (size - section.offset) / (int64_t)c10::elementSize(dtype);
+    for (int64_t d = 0; d < section.dim; d++) {
+      if (section.sizes[d] < 0)
+        AT_ERROR("'", name, "' has a corrupt header");
+      if (section.sizes[d] > 0 && numel > capacity / section.sizes[d])
+        AT_ERROR("'", name, "' is truncated");
+      numel *= section.sizes[d];
+    }
+    if (numel > capacity)
+      AT_ERROR("'", name, "' is truncated");
+
+    std::vector<int64_t> sizes(section.sizes, section.sizes + section.dim);
+    auto options = torch::TensorOptions().dtype(dtype);
+    tensors[i] = torch::from_blob((char *)ptr + section.offset, sizes,
+                                  [mapping](void *) {}, options);
+  }
+
+  if (!tensors[0].has_value() || !tensors[1].has_value())
+    AT_ERROR("'", name, "' is not a valid CSR file");
+
+  // Check that all sections are consistent with each other:
+  const auto M = header->num_rows, N = header->num_cols;
+  auto check_index = [&](const torch::optional<torch::Tensor> &tensor,
+                         int64_t numel) {
+    if (tensor.has_value() &&
+        (tensor.value().scalar_type() != at::kLong ||
+         tensor.value().dim() != 1 || tensor.value().numel() != numel))
+      AT_ERROR("'", name, "' has inconsistent sections");
+  };
+  check_index(tensors[0], M + 1);
+  const auto *rowptr_data = tensors[0].value().data_ptr<int64_t>();
+  const auto E = rowptr_data[M];
+  if (rowptr_data[0] != 0 || E < 0)
+    AT_ERROR("'", name, "' has inconsistent sections");
+  check_index(tensors[1], E);
+  if (tensors[2].has_value() && tensors[2].value().size(0) != E)
+    AT_ERROR("'", name, "' has inconsistent sections");
+  check_index(tensors[3], N + 1);
+  check_index(tensors[4], E);
+  check_index(tensors[5], E);
+  check_index(tensors[6], M);
+  check_index(tensors[7], N);
+  check_index(tensors[8], E);
+
+  return std::make_tuple(tensors[0].value(), tensors[1].value(), tensors[2],
+                         tensors[3], tensors[4], tensors[5], tensors[6],
+                         tensors[7], tensors[8], header->num_rows,
+                         header->num_cols);
+}
+
+static std::string shm_name(const std::string &name) {
+  return name.size() > 0 && name[0] == '/' ? name : "/" + name;
+}
+#endif
+
+csr_sections_t csr_load_cpu(std::string path) {
+#ifdef _WIN32
+  AT_ERROR("Memory-mapped loading is not supported on Windows");
+#else
+  auto fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    AT_ERROR("Could not open '", path, "'");
+  return map_sections(fd, path);
+#endif
+}
+
+// Serializes a matrix into the named shared memory object `name`, to which
+// any process can attach via `shm_store_attach_cpu`. The object lives until
+// it gets removed via `shm_store_unlink_cpu`.
+void shm_store_create_cpu(std::string name, torch::Tensor rowptr,
+                          torch::Tensor col,
+                          torch::optional<torch::Tensor> optional_value,
+                          torch::optional<torch::Tensor> optional_colptr,
+                          torch::optional<torch::Tensor> optional_csr2csc,
+                          torch::optional<torch::Tensor> optional_row,
+                          torch::optional<torch::Tensor> optional_rowcount,
+                          torch::optional<torch::Tensor> optional_colcount,
+                          torch::optional<torch::Tensor> optional_csc2csr,
+                          int64_t num_rows, int64_t num_cols) {
+#ifdef _WIN32
+  AT_ERROR("Shared memory graph stores are not supported on Windows");
+#else
+  std::vector<torch::optional<torch::Tensor>> tensors = {
+      rowptr, col, optional_value, optional_colptr, optional_csr2csc,
+      optional_row, optional_rowcount, optional_colcount, optional_csc2csr};
+
+  CSRHeader header;
+  auto size = make_header(tensors, num_rows, num_cols, &header);
+
+  name = shm_name(name);
+  auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+    AT_ERROR("Could not create shared memory object '", name, "'");
+
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    AT_ERROR("Could not allocate ", size, " bytes of shared memory");
+  }
+
+  auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    AT_ERROR("Could not memory-map '", name, "'");
+  }
+
+  std::memcpy(ptr, &header, sizeof(CSRHeader));
+  for (int64_t i = 0; i < CSR_NUM_SECTIONS; i++) {
+    if (tensors[i].has_value()) {
+      auto tensor = tensors[i].value();
+      std::memcpy((char *)ptr + header.sections[i].offset, tensor.data_ptr(),
+                  nbytes(tensor));
+    }
+  }
+  munmap(ptr, size);
+#endif
+}
+
+csr_sections_t shm_store_attach_cpu(std::string name) {
+#ifdef _WIN32
+  AT_ERROR("Shared memory graph stores are not supported on Windows");
+#else
+  name = shm_name(name);
+  auto fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    AT_ERROR("Could not open shared memory object '", name, "'");
+  return map_sections(fd, name);
+#endif
+}
+
+void shm_store_unlink_cpu(std::string name) {
+#ifdef _WIN32
+  AT_ERROR("Shared memory graph stores are not supported on Windows");
+#else
+  name = shm_name(name);
+  if (shm_unlink(name.c_str()) != 0)
+    AT_ERROR("Could not remove shared memory object '", name, "'");
+#endif
+}
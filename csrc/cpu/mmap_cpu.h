@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../extensions.h"
+
+typedef std::tuple<torch::Tensor, torch::Tensor, torch::optional<torch::Tensor>,
+                   torch::optional<torch::Tensor>,
+                   torch::optional<torch::Tensor>,
+                   torch::optional<torch::Tensor>,
+                   torch::optional<torch::Tensor>,
+                   torch::optional<torch::Tensor>,
+                   torch::optional<torch::Tensor>, int64_t, int64_t>
+    csr_sections_t;
+
+void csr_save_cpu(std::string path, torch::Tensor rowptr, torch::Tensor col,
+                  torch::optional<torch::Tensor> optional_value,
+                  torch::optional<torch::Tensor> optional_colptr,
+                  torch::optional<torch::Tensor> optional_csr2csc,
+                  torch::optional<torch::Tensor> optional_row,
+                  torch::optional<torch::Tensor> optional_rowcount,
+                  torch::optional<torch::Tensor> optional_colcount,
+                  torch::optional<torch::Tensor> optional_csc2csr,
+                  int64_t num_rows, int64_t num_cols);
+
+csr_sections_t csr_load_cpu(std::string path);
+
+void shm_store_create_cpu(std::string name, torch::Tensor rowptr,
+                          torch::Tensor col,
+                          torch::optional<torch::Tensor> optional_value,
+                          torch::optional<torch::Tensor> optional_colptr,
+                          torch::optional<torch::Tensor> optional_csr2csc,
+                          torch::optional<torch::Tensor> optional_row,
+                          torch::optional<torch::Tensor> optional_rowcount,
+                          torch::optional<torch::Tensor> optional_colcount,
+                          torch::optional<torch::Tensor> optional_csc2csr,
+                          int64_t num_rows, int64_t num_cols);
+
+csr_sections_t shm_store_attach_cpu(std::string name);
+
+void shm_store_unlink_cpu(std::string name);
@@ -1,21 +1,217 @@
 #include "neighbor_sample_cpu.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+
 #include "utils.h"
 
 #ifdef _WIN32
 #include <process.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
 
 namespace {
 
+// Number of frontier nodes whose neighborhoods get prefetched at once, and
+// the number of blocks the prefetcher may run ahead of the sampler:
+const int64_t PREFETCH_BLOCK_SIZE = 256;
+const int64_t PREFETCH_LOOKAHEAD = 8;
+
+// Faults in the pages backing the neighborhoods `row[colptr[w]:colptr[w+1]]`
+// of `nodes` ahead of the sampler. With a memory-mapped adjacency, this
+// turns page faults on the sampling thread into asynchronous readahead
+// (`madvise`) and concurrent reads issued by `num_threads` I/O threads, so
+// that I/O overlaps with sampling. Without I/O threads, readahead is only
+// requested for upcoming blocks.
+class Prefetcher {
+public:
+  Prefetcher(const int64_t *colptr_data, const int64_t *row_data,
+             vector<int64_t> nodes, int64_t num_threads)
+      : colptr_data(colptr_data), row_data(row_data), nodes(move(nodes)) {
+    num_blocks = (this->nodes.size() + PREFETCH_BLOCK_SIZE - 1) /
+                 PREFETCH_BLOCK_SIZE;
+    for (int64_t t = 0; t < num_threads; t++)
+      threads.emplace_back([this] { work(); });
+  }
+
+  ~Prefetcher() {
+    {
+      lock_guard<mutex> lock(m);
+      stopped = true;
+    }
+    cv.notify_all();
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  // Signals that the sampler reached the `k`-th node:
+  void advance(int64_t k) {
+    if (k % PREFETCH_BLOCK_SIZE != 0)
+      return;
+
+    auto block = k / PREFETCH_BLOCK_SIZE;
+    if (threads.empty()) {
+      if (block + 1 < num_blocks)
+        prefetch(block + 1, false);
+      return;
+    }
+    {
+      lock_guard<mutex> lock(m);
+      current = block;
+    }
+    cv.notify_all();
+  }
+
+private:
+  void work() {
+    while (true) {
+      auto block = next++;
+      if (block >= num_blocks)
+        return;
+      {
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [&] {
+          return stopped || block <= current + PREFETCH_LOOKAHEAD;
+        });
+        if (stopped)
+          return;
+      }
+      prefetch(block, true);
+    }
+  }
+
+  void prefetch(int64_t block, bool touch) {
+    auto begin = block * PREFETCH_BLOCK_SIZE;
+    auto end = min(begin + PREFETCH_BLOCK_SIZE, (int64_t)nodes.size());
+    for (auto k = begin; k < end; k++) {
+      const auto &w = nodes[k];
+      prefetch_range(row_data + colptr_data[w], row_data + colptr_data[w + 1],
+                     touch);
+    }
+  }
+
+  static void prefetch_range(const int64_t *begin, const int64_t *end,
+                             bool touch) {
+    if (begin >= end)
+      return;
+#ifdef _WIN32
+    const uintptr_t page_size = 4096;
+#else
+    static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+#endif
+    auto first = (uintptr_t)begin & ~(page_size - 1);
+    auto last = (uintptr_t)end;
+#ifndef _WIN32
+    madvise((void *)first, last - first, MADV_WILLNEED);
+#endif
+    if (touch) {
+      for (auto page = first; page < last; page += page_size)
+        (void)*(volatile const char *)max(page, (uintptr_t)begin);
+    }
+  }
+
+  const int64_t *colptr_data;
+  const int64_t *row_data;
+  const vector<int64_t> nodes;
+  int64_t num_blocks;
+
+  vector<thread> threads;
+  atomic<int64_t> next{0};
+  mutex m;
+  condition_variable cv;
+  int64_t current = 0;
+  bool stopped = false;
+};
+
+// Returns the local indices `[begin, end)` of `samples` in the order in
+// which they get expanded. In out-of-core mode, nodes are visited by
+// increasing offset of their neighborhood for page locality.
+vector<int64_t> frontier_order(const int64_t *colptr_data,
+                               const vector<int64_t> &samples, int64_t begin,
+                               int64_t end, bool out_of_core) {
+  vector<int64_t> order(end - begin);
+  iota(order.begin(), order.end(), begin);
+  if (out_of_core) {
+    sort(order.begin(), order.end(), [&](const int64_t &a, const int64_t &b) {
+      return colptr_data[samples[a]] < colptr_data[samples[b]];
+    });
+  }
+  return order;
+}
+
+vector<int64_t> frontier_nodes(const vector<int64_t> &samples,
+                               const vector<int64_t> &order) {
+  vector<int64_t> nodes(order.size());
+  for (int64_t k = 0; k < (int64_t)order.size(); k++)
+    nodes[k] = samples[order[k]];
+  return nodes;
+}
+
+// Copies the rows `src[index]` into the leading rows of `out` (or of a newly
+// allocated tensor if `out` is not given) in parallel, and returns them.
+torch::Tensor gather_rows(const torch::Tensor &src, const torch::Tensor &index,
+                          torch::optional<torch::Tensor> optional_out) {
+  CHECK_CPU(src);
+  CHECK_INPUT(src.dim() >= 1);
+  auto src_c = src.contiguous();
+  auto sizes = src_c.sizes().vec();
+  sizes[0] = index.numel();
+
+  torch::Tensor out;
+  if (optional_out.has_value()) {
+    out = optional_out.value();
+    CHECK_CPU(out);
+    CHECK_INPUT(out.is_contiguous());
+    CHECK_INPUT(out.scalar_type() == src_c.scalar_type());
+    CHECK_INPUT(out.dim() == src_c.dim());
+    for (int64_t d = 1; d < src_c.dim(); d++)
+      CHECK_INPUT(out.size(d) == src_c.size(d));
+    CHECK_INPUT(out.size(0) >= index.numel());
+    out = out.narrow(0, 0, index.numel());
+  } else {
+    out = torch::empty(sizes, src_c.options());
+  }
+
+  if (index.numel() == 0 || src_c.numel() == 0)
+    return out;
+
+  CHECK_INPUT(index.min().item<int64_t>() >= 0);
+  CHECK_INPUT(index.max().item<int64_t>() < src_c.size(0));
+
+  const auto row_bytes = src_c.stride(0) * src_c.element_size();
+  const auto *src_data = (const char *)src_c.data_ptr();
+  auto *out_data = (char *)out.data_ptr();
+  const auto *index_data = index.data_ptr<int64_t>();
+
+  int64_t grain_size =
+      max(at::internal::GRAIN_SIZE / max(src_c.stride(0), (int64_t)1),
+          (int64_t)1);
+  at::parallel_for(0, index.numel(), grain_size, [&](int64_t b, int64_t e) {
+    for (auto k = b; k < e; k++)
+      memcpy(out_data + k * row_bytes, src_data + index_data[k] * row_bytes,
+             row_bytes);
+  });
+  return out;
+}
+
 template <bool replace, bool directed>
 tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
 sample(const torch::Tensor &colptr, const torch::Tensor &row,
-       const torch::Tensor &input_node, const vector<int64_t> num_neighbors) {
+       const torch::Tensor &input_node, const vector<int64_t> num_neighbors,
+       const int64_t num_io_threads = -1) {
 
-  srand(time(NULL) + 1000 * getpid()); // Initialize random seed.
+  // Every call draws from its own generator, so that concurrent pipeline
+  // workers neither race on nor correlate through the global `rand()` state:
+  mt19937 generator(random_device{}());
 
   // Initialize some data structures for the sampling process:
   vector<int64_t> samples;
@@ -33,11 +229,23 @@ sample(const torch::Tensor &colptr, const torch::Tensor &row,
 
   vector<int64_t> rows, cols, edges;
 
+  // A negative number of I/O threads denotes in-memory sampling:
+  const bool out_of_core = num_io_threads >= 0;
+
   int64_t begin = 0, end = samples.size();
   for (int64_t ell = 0; ell < (int64_t)num_neighbors.size(); ell++) {
     const auto &num_samples = num_neighbors[ell];
-    for (int64_t i = begin; i < end; i++) {
-      const auto &w = samples[i];
+    const auto order =
+        frontier_order(colptr_data, samples, begin, end, out_of_core);
+    Prefetcher prefetcher(colptr_data, row_data,
+                          out_of_core ? frontier_nodes(samples, order)
+                                      : vector<int64_t>(),
+                          max(num_io_threads, (int64_t)0));
+    for (int64_t k = 0; k < (int64_t)order.size(); k++) {
+      if (out_of_core)
+        prefetcher.advance(k);
+      const int64_t i = order[k];
+      const auto w = samples[i];
       const auto &col_start = colptr_data[w];
       const auto &col_end = colptr_data[w + 1];
       const auto col_count = col_end - col_start;
@@ -58,8 +266,9 @@ sample(const torch::Tensor &colptr, const torch::Tensor &row,
           }
         }
       } else if (replace) {
+        uniform_int_distribution<int64_t> dist(0, col_count - 1);
         for (int64_t j = 0; j < num_samples; j++) {
-          const int64_t offset = col_start + rand() % col_count;
+          const int64_t offset = col_start + dist(generator);
           const int64_t &v = row_data[offset];
           const auto res = to_local_node.insert({v, samples.size()});
           if (res.second)
@@ -73,7 +282,7 @@ sample(const torch::Tensor &colptr, const torch::Tensor &row,
       } else {
         unordered_set<int64_t> rnd_indices;
         for (int64_t j = col_count - num_samples; j < col_count; j++) {
-          int64_t rnd = rand() % j;
+          int64_t rnd = uniform_int_distribution<int64_t>(0, j)(generator);
           if (!rnd_indices.insert(rnd).second) {
             rnd = j;
             rnd_indices.insert(j);
@@ -95,8 +304,17 @@ sample(const torch::Tensor &colptr, const torch::Tensor &row,
   }
 
   if (!directed) {
+    const auto order =
+        frontier_order(colptr_data, samples, 0, samples.size(), out_of_core);
+    Prefetcher prefetcher(colptr_data, row_data,
+                          out_of_core ? frontier_nodes(samples, order)
+                                      : vector<int64_t>(),
+                          max(num_io_threads, (int64_t)0));
     unordered_map<int64_t, int64_t>::iterator iter;
-    for (int64_t i = 0; i < (int64_t)samples.size(); i++) {
+    for (int64_t k = 0; k < (int64_t)order.size(); k++) {
+      if (out_of_core)
+        prefetcher.advance(k);
+      const int64_t i = order[k];
       const auto &w = samples[i];
       const auto &col_start = colptr_data[w];
       const auto &col_end = colptr_data[w + 1];
@@ -127,7 +345,7 @@ hetero_sample(const vector<node_t> &node_types,
               const c10::Dict<rel_t, vector<int64_t>> &num_neighbors_dict,
               const int64_t num_hops) {
 
-  srand(time(NULL) + 1000 * getpid()); // Initialize random seed.
+  mt19937 generator(random_device{}()); // Initialize random seed.
 
   // Create a mapping to convert single string relations to edge type triplets:
   unordered_map<rel_t, edge_t> to_edge_type;
@@ -211,8 +429,9 @@ hetero_sample(const vector<node_t> &node_types,
             }
           }
         } else if (replace) {
+          uniform_int_distribution<int64_t> dist(0, col_count - 1);
           for (int64_t j = 0; j < num_samples; j++) {
-            const int64_t offset = col_start + rand() % col_count;
+            const int64_t offset = col_start + dist(generator);
             const int64_t &v = row_data[offset];
             const auto res = to_local_src_node.insert({v, src_samples.size()});
             if (res.second)
@@ -226,7 +445,7 @@ hetero_sample(const vector<node_t> &node_types,
         } else {
           unordered_set<int64_t> rnd_indices;
           for (int64_t j = col_count - num_samples; j < col_count; j++) {
-            int64_t rnd = rand() % j;
+            int64_t rnd = uniform_int_distribution<int64_t>(0, j)(generator);
             if (!rnd_indices.insert(rnd).second) {
               rnd = j;
               rnd_indices.insert(j);
@@ -293,6 +512,34 @@ hetero_sample(const vector<node_t> &node_types,
 
 } // namespace
 
+// Neighbor sampling over adjacencies that may not be resident in memory,
+// e.g., loaded via `csr_load`: Every frontier gets expanded in the order of
+// its neighborhoods on disk, and upcoming neighborhoods get prefetched by
+// `num_io_threads` I/O threads while sampling.
+tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+out_of_core_neighbor_sample_cpu(const torch::Tensor &colptr,
+                                const torch::Tensor &row,
+                                const torch::Tensor &input_node,
+                                const vector<int64_t> num_neighbors,
+                                const bool replace, const bool directed,
+                                const int64_t num_io_threads) {
+  CHECK_INPUT(num_io_threads >= 0);
+
+  if (replace && directed) {
+    return sample<true, true>(colptr, row, input_node, num_neighbors,
+                              num_io_threads);
+  } else if (replace && !directed) {
+    return sample<true, false>(colptr, row, input_node, num_neighbors,
+                               num_io_threads);
+  } else if (!replace && directed) {
+    return sample<false, true>(colptr, row, input_node, num_neighbors,
+                               num_io_threads);
+  } else {
+    return sample<false, false>(colptr, row, input_node, num_neighbors,
+                                num_io_threads);
+  }
+}
+
 tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
 neighbor_sample_cpu(const torch::Tensor &colptr, const torch::Tensor &row,
                     const torch::Tensor &input_node,
@@ -310,6 +557,141 @@ neighbor_sample_cpu(const torch::Tensor &colptr, const torch::Tensor &row,
   }
 }
 
+NeighborSamplerPipeline::NeighborSamplerPipeline(
+    const torch::Tensor &colptr, const torch::Tensor &row,
+    const torch::Tensor &input_node, const int64_t batch_size,
+    const vector<int64_t> num_neighbors, const bool replace,
+    const bool directed, const int64_t num_workers, const int64_t queue_size)
+    : colptr(colptr), row(row), input_node(input_node.contiguous()),
+      batch_size(batch_size), num_neighbors(num_neighbors), replace(replace),
+      directed(directed), queue_size(queue_size) {
+  CHECK_CPU(colptr);
+  CHECK_CPU(row);
+  CHECK_CPU(input_node);
+  CHECK_INPUT(input_node.dim() == 1);
+  CHECK_INPUT(batch_size > 0);
+  CHECK_INPUT(num_workers > 0);
+  CHECK_INPUT(queue_size > 0);
+
+  total = (this->input_node.numel() + batch_size - 1) / batch_size;
+  slots.resize(queue_size);
+  errors.resize(queue_size);
+  ready.resize(queue_size, false);
+
+  for (int64_t t = 0; t < min(num_workers, total); t++)
+    workers.emplace_back([this] { work(); });
+}
+
+NeighborSamplerPipeline::~NeighborSamplerPipeline() {
+  {
+    lock_guard<mutex> lock(m);
+    stopped = true;
+  }
+  not_full.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+
+// Batch `b` is written to slot `b % queue_size`, and may only get claimed
+// once its previous occupant `b - queue_size` has been consumed:
+void NeighborSamplerPipeline::work() {
+  while (true) {
+    int64_t b;
+    {
+      unique_lock<mutex> lock(m);
+      not_full.wait(lock, [&] {
+        return stopped || claimed >= total || claimed < consumed + queue_size;
+      });
+      if (stopped || claimed >= total)
+        return;
+      b = claimed++;
+    }
+
+    vector<torch::Tensor> out;
+    string error;
+    try {
+      const auto start = b * batch_size;
+      const auto length = min(batch_size, input_node.numel() - start);
+      const auto result =
+          neighbor_sample_cpu(colptr, row, input_node.narrow(0, start, length),
+                              num_neighbors, replace, directed);
+      out = {get<0>(result), get<1>(result), get<2>(result), get<3>(result)};
+    } catch (const exception &e) {
+      error = e.what();
+    }
+
+    {
+      lock_guard<mutex> lock(m);
+      slots[b % queue_size] = move(out);
+      errors[b % queue_size] = move(error);
+      ready[b % queue_size] = true;
+    }
+    not_empty.notify_all();
+  }
+}
+
+vector<torch::Tensor> NeighborSamplerPipeline::next() {
+  unique_lock<mutex> lock(m);
+  if (consumed >= total)
+    return {};
+
+  const auto s = consumed % queue_size;
+  not_empty.wait(lock, [&] { return (bool)ready[s]; });
+  auto out = move(slots[s]);
+  auto error = move(errors[s]);
+  ready[s] = false;
+  consumed++;
+  lock.unlock();
+  not_full.notify_all();
+
+  if (!error.empty())
+    AT_ERROR(error);
+  return out;
+}
+
+int64_t NeighborSamplerPipeline::num_batches() const { return total; }
+
+// Neighbor sampling fused with the gather of node features `x[output_node]`
+// and edge features `edge_attr[output_edge]`, which get written in parallel
+// into the (e.g., shared memory) buffers `x_out` and `edge_out` if given.
+// Buffers need to provide enough leading rows for the sampled subgraph, and
+// the returned features are views into them.
+tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+      torch::optional<torch::Tensor>, torch::optional<torch::Tensor>>
+neighbor_sample_gather_cpu(const torch::Tensor &colptr,
+                           const torch::Tensor &row,
+                           const torch::Tensor &input_node,
+                           const vector<int64_t> num_neighbors,
+                           const bool replace, const bool directed,
+                           torch::optional<torch::Tensor> optional_x,
+                           torch::optional<torch::Tensor> optional_x_out,
+                           torch::optional<torch::Tensor> optional_edge_attr,
+                           torch::optional<torch::Tensor> optional_edge_out) {
+
+  // Features need to cover every node and edge that can get sampled:
+  if (optional_x.has_value()) {
+    CHECK_INPUT(optional_x.value().dim() >= 1);
+    CHECK_INPUT(optional_x.value().size(0) >= colptr.numel() - 1);
+  }
+  if (optional_edge_attr.has_value()) {
+    CHECK_INPUT(optional_edge_attr.value().dim() >= 1);
+    CHECK_INPUT(optional_edge_attr.value().size(0) >= row.numel());
+  }
+
+  torch::Tensor node, out_row, out_col, edge;
+  tie(node, out_row, out_col, edge) = neighbor_sample_cpu(
+      colptr, row, input_node, num_neighbors, replace, directed);
+
+  torch::optional<torch::Tensor> x_out = torch::nullopt;
+  torch::optional<torch::Tensor> edge_out = torch::nullopt;
+  if (optional_x.has_value())
+    x_out = gather_rows(optional_x.value(), node, optional_x_out);
+  if (optional_edge_attr.has_value())
+    edge_out = gather_rows(optional_edge_attr.value(), edge, optional_edge_out);
+
+  return make_tuple(node, out_row, out_col, edge, x_out, edge_out);
+}
+
 tuple<c10::Dict<node_t, torch::Tensor>, c10::Dict<rel_t, torch::Tensor>,
       c10::Dict<rel_t, torch::Tensor>, c10::Dict<rel_t, torch::Tensor>>
 hetero_neighbor_sample_cpu(
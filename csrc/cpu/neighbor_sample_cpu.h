@@ -1,5 +1,9 @@
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "../extensions.h"
 
 typedef std::string node_t;
@@ -12,6 +16,64 @@ neighbor_sample_cpu(const torch::Tensor &colptr, const torch::Tensor &row,
                     const std::vector<int64_t> num_neighbors,
                     const bool replace, const bool directed);
 
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+           torch::optional<torch::Tensor>, torch::optional<torch::Tensor>>
+neighbor_sample_gather_cpu(const torch::Tensor &colptr,
+                           const torch::Tensor &row,
+                           const torch::Tensor &input_node,
+                           const std::vector<int64_t> num_neighbors,
+                           const bool replace, const bool directed,
+                           torch::optional<torch::Tensor> optional_x,
+                           torch::optional<torch::Tensor> optional_x_out,
+                           torch::optional<torch::Tensor> optional_edge_attr,
+                           torch::optional<torch::Tensor> optional_edge_out);
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+out_of_core_neighbor_sample_cpu(const torch::Tensor &colptr,
+                                const torch::Tensor &row,
+                                const torch::Tensor &input_node,
+                                const std::vector<int64_t> num_neighbors,
+                                const bool replace, const bool directed,
+                                const int64_t num_io_threads);
+
+// Samples consecutive batches of `input_node` ahead of time on a pool of
+// `num_workers` native threads via `neighbor_sample_cpu`. At most
+// `queue_size` sampled batches are buffered, and `next()` hands them out in
+// batch order as `[output_node, row, col, output_edge]`, or as an empty list
+// once all batches have been consumed.
+class NeighborSamplerPipeline : public torch::CustomClassHolder {
+public:
+  NeighborSamplerPipeline(const torch::Tensor &colptr, const torch::Tensor &row,
+                          const torch::Tensor &input_node,
+                          const int64_t batch_size,
+                          const std::vector<int64_t> num_neighbors,
+                          const bool replace, const bool directed,
+                          const int64_t num_workers, const int64_t queue_size);
+  ~NeighborSamplerPipeline();
+
+  std::vector<torch::Tensor> next();
+  int64_t num_batches() const;
+
+private:
+  void work();
+
+  torch::Tensor colptr, row, input_node;
+  int64_t batch_size;
+  std::vector<int64_t> num_neighbors;
+  bool replace, directed;
+  int64_t queue_size;
+
+  std::vector<std::vector<torch::Tensor>> slots;
+  std::vector<std::string> errors;
+  std::vector<char> ready;
+  int64_t total = 0, claimed = 0, consumed = 0;
+  bool stopped = false;
+
+  std::mutex m;
+  std::condition_variable not_full, not_empty;
+  std::vector<std::thread> workers;
+};
+
 std::tuple<c10::Dict<node_t, torch::Tensor>, c10::Dict<rel_t, torch::Tensor>,
            c10::Dict<rel_t, torch::Tensor>, c10::Dict<rel_t, torch::Tensor>>
 hetero_neighbor_sample_cpu(
@@ -0,0 +1,143 @@
+#include "padding_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+// Generates a degree-binned, padded (sliced-ELL) layout of a CSR matrix.
+// Nodes are grouped into bins according to `binptr`, i.e., node `n` falls
+// into bin `b` if `binptr[b] <= rowcount[n] < binptr[b + 1]` (nodes with
+// larger degrees fall into the last bin). Within each bin, the neighborhood
+// of every node is padded to the maximum degree of that bin, so that each
+// bin can be processed as a dense `[node_size[b], edge_size[b] /
+// node_size[b]]` block. Returns:
+// * `node_perm`: The node ordering grouped by bin.
+// * `row_perm`, `col_perm`: The source row and column of every padded slot,
+//   or `-1` for padding entries.
+// * `mask`: Whether a slot corresponds to a padding entry.
+// * `node_size`, `edge_size`: The number of nodes and slots of every bin.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+           std::vector<int64_t>, std::vector<int64_t>>
+padded_index_cpu(torch::Tensor rowptr, torch::Tensor col,
+                 torch::Tensor rowcount, torch::Tensor binptr) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(rowcount);
+  CHECK_CPU(binptr);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(rowcount.dim() == 1);
+  CHECK_INPUT(binptr.dim() == 1);
+  CHECK_INPUT(rowptr.numel() == rowcount.numel() + 1);
+  CHECK_INPUT(binptr.numel() >= 2);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+  rowcount = rowcount.contiguous(), binptr = binptr.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto rowcount_data = rowcount.data_ptr<int64_t>();
+  auto binptr_data = binptr.data_ptr<int64_t>();
+
+  auto N = rowcount.numel();
+  auto B = binptr.numel() - 1;
+
+  // Assign nodes to bins and compute the padded length of every bin:
+  std::vector<int64_t> bin(N), node_size(B, 0), bin_length(B, 0);
+  int64_t n, b;
+  for (n = 0; n < N; n++) {
+    b = std::upper_bound(binptr_data, binptr_data + B, rowcount_data[n]) -
+        binptr_data - 1;
+    b = std::min(std::max(b, (int64_t)0), B - 1);
+    bin[n] = b;
+    node_size[b]++;
+    bin_length[b] = std::max(bin_length[b], rowcount_data[n]);
+  }
+
+  std::vector<int64_t> edge_size(B), node_offset(B + 1, 0),
+      edge_offset(B + 1, 0);
+  for (b = 0; b < B; b++) {
+    edge_size[b] = node_size[b] * bin_length[b];
+    node_offset[b + 1] = node_offset[b] + node_size[b];
+    edge_offset[b + 1] = edge_offset[b] + edge_size[b];
+  }
+
+  // Group nodes by bin (stable w.r.t. node ids):
+  auto node_perm = torch::empty(N, rowptr.options());
+  auto node_perm_data = node_perm.data_ptr<int64_t>();
+  std::vector<int64_t> cursor(node_offset.begin(), node_offset.end() - 1);
+  for (n = 0; n < N; n++)
+    node_perm_data[cursor[bin[n]]++] = n;
+
+  auto E = edge_offset[B];
+  auto row_perm = torch::empty(E, col.options());
+  auto col_perm = torch::empty(E, col.options());
+  auto mask = torch::empty(E, col.options().dtype(torch::kBool));
+  auto row_perm_data = row_perm.data_ptr<int64_t>();
+  auto col_perm_data = col_perm.data_ptr<int64_t>();
+  auto mask_data = mask.data_ptr<bool>();
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(E / std::max(N, (int64_t)1), (int64_t)1);
+  at::parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t n, b, length, offset, row_start, deg;
+    for (auto i = begin; i < end; i++) {
+      n = node_perm_data[i], b = bin[n], length = bin_length[b];
+      offset = edge_offset[b] + (i - node_offset[b]) * length;
+      row_start = rowptr_data[n], deg = rowcount_data[n];
+      for (int64_t k = 0; k < length; k++) {
+        row_perm_data[offset + k] = k < deg ? n : -1;
+        col_perm_data[offset + k] = k < deg ? col_data[row_start + k] : -1;
+        mask_data[offset + k] = k >= deg;
+      }
+    }
+  });
+
+  return std::make_tuple(node_perm, row_perm, col_perm, mask, node_size,
+                         edge_size);
+}
+
+// Gathers the rows `index` of `src`, and fills rows for which `index == -1`
+// with `fill_value`.
+torch::Tensor padded_index_select_cpu(torch::Tensor src, torch::Tensor index,
+                                      torch::Tensor fill_value) {
+  CHECK_CPU(src);
+  CHECK_CPU(index);
+  CHECK_INPUT(src.dim() >= 1);
+  CHECK_INPUT(index.dim() == 1);
+
+  src = src.contiguous(), index = index.contiguous();
+
+  auto sizes = src.sizes().vec();
+  sizes[0] = index.numel();
+  auto out = torch::empty(sizes, src.options());
+
+  auto N = src.size(0);
+  auto E = index.numel();
+  auto F = src.numel() / std::max(N, (int64_t)1);
+  auto index_data = index.data_ptr<int64_t>();
+
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, src.scalar_type(), "_",
+      [&] {
+        auto src_data = src.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+        auto fill = fill_value.to(src.scalar_type()).item<scalar_t>();
+
+        int64_t grain_size =
+            at::internal::GRAIN_SIZE / std::max(F, (int64_t)1);
+        at::parallel_for(0, E, grain_size, [&](int64_t begin, int64_t end) {
+          int64_t idx;
+          for (auto e = begin; e < end; e++) {
+            idx = index_data[e];
+            if (idx < -1 || idx >= N)
+              AT_ERROR("Index ", idx, " out of range for size ", N);
+            for (int64_t f = 0; f < F; f++)
+              out_data[e * F + f] = idx == -1 ? fill : src_data[idx * F + f];
+          }
+        });
+      });
+
+  return out;
+}
@@ -0,0 +1,74 @@
+#include "permute_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+// Symmetrically permutes a quadratic CSR matrix, i.e., it computes
+// `A[perm][:, perm]` in a single pass: Row `i` of the output holds the
+// entries of row `perm[i]`, whose columns get relabeled through the inverse
+// permutation and sorted afterwards. Returns the output pattern and the
+// permutation into the input entries, so that values can be gathered
+// afterwards.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+permute_cpu(torch::Tensor rowptr, torch::Tensor col, torch::Tensor perm) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(perm);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(perm.dim() == 1);
+  CHECK_INPUT(rowptr.numel() - 1 == perm.numel());
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+  perm = perm.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto perm_data = perm.data_ptr<int64_t>();
+  auto N = perm.numel();
+
+  std::vector<int64_t> inv_perm(N, -1);
+  auto out_rowptr = torch::empty(N + 1, rowptr.options());
+  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+  out_rowptr_data[0] = 0;
+  int64_t i, r;
+  for (i = 0; i < N; i++) {
+    r = perm_data[i];
+    if (r < 0 || r >= N || inv_perm[r] != -1)
+      AT_ERROR("Argument `perm` needs to be a permutation");
+    inv_perm[r] = i;
+    out_rowptr_data[i + 1] =
+        out_rowptr_data[i] + rowptr_data[r + 1] - rowptr_data[r];
+  }
+
+  auto E = col.numel();
+  auto out_col = torch::empty(E, col.options());
+  auto out_perm = torch::empty(E, col.options());
+  auto out_col_data = out_col.data_ptr<int64_t>();
+  auto out_perm_data = out_perm.data_ptr<int64_t>();
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(E / std::max(N, (int64_t)1), (int64_t)1);
+  at::parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int64_t, int64_t>> buffer;
+    int64_t offset;
+    for (auto i = begin; i < end; i++) {
+      buffer.clear();
+      for (auto e = rowptr_data[perm_data[i]];
+           e < rowptr_data[perm_data[i] + 1]; e++)
+        buffer.push_back(std::make_pair(inv_perm[col_data[e]], e));
+      std::sort(buffer.begin(), buffer.end());
+
+      offset = out_rowptr_data[i];
+      for (const auto &entry : buffer) {
+        out_col_data[offset] = entry.first;
+        out_perm_data[offset] = entry.second;
+        offset++;
+      }
+    }
+  });
+
+  return std::make_tuple(out_rowptr, out_col, out_perm);
+}
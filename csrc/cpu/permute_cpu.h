@@ -0,0 +1,6 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+permute_cpu(torch::Tensor rowptr, torch::Tensor col, torch::Tensor perm);
@@ -67,18 +67,21 @@ template <typename scalar_t, ReductionType REDUCE> struct Reducer {
     }
   }
 
-  static inline void write(scalar_t *address, scalar_t val,
-                           int64_t *arg_address, int64_t arg, int count) {
+  // `out_t` may differ from `scalar_t` in case we accumulate reduced
+  // precision inputs in a wider type, see `AccType`.
+  template <typename out_t>
+  static inline void write(out_t *address, scalar_t val, int64_t *arg_address,
+                           int64_t arg, int count) {
     if (REDUCE == SUM || REDUCE == MUL || REDUCE == DIV)
-      *address = val;
+      *address = (out_t)val;
     else if (REDUCE == MEAN)
-      *address = val / (scalar_t)(count > 0 ? count : 1);
+      *address = (out_t)(val / (scalar_t)(count > 0 ? count : 1));
     else if (REDUCE == MIN || REDUCE == MAX) {
       if (count > 0) {
-        *address = val;
+        *address = (out_t)val;
         *arg_address = arg;
       } else
-        *address = (scalar_t)0;
+        *address = (out_t)0;
     }
   }
 };
@@ -1,10 +1,6 @@
 #include "sample_cpu.h"
 
-#include "utils.h"
-
-#ifdef _WIN32
-#include <process.h>
-#endif
+#include "sample_utils.h"
 
 // Returns `rowptr`, `col`, `n_id`, `e_id`
 std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
@@ -15,128 +11,64 @@ sample_adj_cpu(torch::Tensor rowptr, torch::Tensor col, torch::Tensor idx,
   CHECK_CPU(idx);
   CHECK_INPUT(idx.dim() == 1);
 
-  srand(time(NULL) + 1000 * getpid()); // Initialize random seed.
+  idx = idx.contiguous();
 
   auto rowptr_data = rowptr.data_ptr<int64_t>();
   auto col_data = col.data_ptr<int64_t>();
   auto idx_data = idx.data_ptr<int64_t>();
+  auto M = idx.numel();
 
-  auto out_rowptr = torch::empty(idx.numel() + 1, rowptr.options());
-  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
-  out_rowptr_data[0] = 0;
-
-  std::vector<std::vector<std::tuple<int64_t, int64_t>>> cols; // col, e_id
-  std::vector<int64_t> n_ids;
-  std::unordered_map<int64_t, int64_t> n_id_map;
-
-  int64_t i;
-  for (int64_t n = 0; n < idx.numel(); n++) {
-    i = idx_data[n];
-    cols.push_back(std::vector<std::tuple<int64_t, int64_t>>());
-    n_id_map[i] = n;
-    n_ids.push_back(i);
-  }
-
-  int64_t n, c, e, row_start, row_end, row_count;
-
-  if (num_neighbors < 0) { // No sampling ======================================
-
-    for (int64_t i = 0; i < idx.numel(); i++) {
-      n = idx_data[i];
-      row_start = rowptr_data[n], row_end = rowptr_data[n + 1];
-      row_count = row_end - row_start;
-
-      for (int64_t j = 0; j < row_count; j++) {
-        e = row_start + j;
-        c = col_data[e];
-
-        if (n_id_map.count(c) == 0) {
-          n_id_map[c] = n_ids.size();
-          n_ids.push_back(c);
-        }
-        cols[i].push_back(std::make_tuple(n_id_map[c], e));
-      }
-      out_rowptr_data[i + 1] = out_rowptr_data[i] + cols[i].size();
-    }
-  }
-
-  else if (replace) { // Sample with replacement ===============================
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(num_neighbors < 0
+                                    ? col.numel() / std::max(M, (int64_t)1)
+                                    : num_neighbors,
+                                (int64_t)1);
 
-    for (int64_t i = 0; i < idx.numel(); i++) {
-      n = idx_data[i];
-      row_start = rowptr_data[n], row_end = rowptr_data[n + 1];
-      row_count = row_end - row_start;
-
-      if (row_count > 0) {
-        for (int64_t j = 0; j < num_neighbors; j++) {
-          e = row_start + rand() % row_count;
-          c = col_data[e];
-
-          if (n_id_map.count(c) == 0) {
-            n_id_map[c] = n_ids.size();
-            n_ids.push_back(c);
-          }
-          cols[i].push_back(std::make_tuple(n_id_map[c], e));
-        }
-      }
-      out_rowptr_data[i + 1] = out_rowptr_data[i] + cols[i].size();
-    }
-
-  } else { // Sample without replacement via Robert Floyd algorithm ============
-
-    for (int64_t i = 0; i < idx.numel(); i++) {
+  // Count the number of sampled neighbors per row:
+  auto out_rowptr = torch::zeros(M + 1, rowptr.options());
+  auto out_rowptr_data = out_rowptr.data_ptr<int64_t>();
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t n;
+    for (auto i = begin; i < end; i++) {
       n = idx_data[i];
-      row_start = rowptr_data[n], row_end = rowptr_data[n + 1];
-      row_count = row_end - row_start;
-
-      std::unordered_set<int64_t> perm;
-      if (row_count <= num_neighbors) {
-        for (int64_t j = 0; j < row_count; j++)
-          perm.insert(j);
-      } else { // See: https://www.nowherenearithaca.com/2013/05/
-               //      robert-floyds-tiny-and-beautiful.html
-        for (int64_t j = row_count - num_neighbors; j < row_count; j++) {
-          if (!perm.insert(rand() % j).second)
-            perm.insert(j);
-        }
-      }
-
-      for (const int64_t &p : perm) {
-        e = row_start + p;
-        c = col_data[e];
-
-        if (n_id_map.count(c) == 0) {
-          n_id_map[c] = n_ids.size();
-          n_ids.push_back(c);
-        }
-        cols[i].push_back(std::make_tuple(n_id_map[c], e));
-      }
-      out_rowptr_data[i + 1] = out_rowptr_data[i] + cols[i].size();
+      out_rowptr_data[i + 1] = sample_count(
+          rowptr_data[n + 1] - rowptr_data[n], num_neighbors, replace);
     }
-  }
-
-  int64_t N = n_ids.size();
-  auto out_n_id = torch::from_blob(n_ids.data(), {N}, col.options()).clone();
+  });
+  out_rowptr = out_rowptr.cumsum(0);
+  out_rowptr_data = out_rowptr.data_ptr<int64_t>();
 
-  int64_t E = out_rowptr_data[idx.numel()];
-  auto out_col = torch::empty(E, col.options());
-  auto out_col_data = out_col.data_ptr<int64_t>();
+  // Fill in the sampled edge IDs of every row in place:
+  int64_t E = out_rowptr_data[M];
   auto out_e_id = torch::empty(E, col.options());
   auto out_e_id_data = out_e_id.data_ptr<int64_t>();
 
-  i = 0;
-  for (std::vector<std::tuple<int64_t, int64_t>> &col_vec : cols) {
-    std::sort(col_vec.begin(), col_vec.end(),
-              [](const std::tuple<int64_t, int64_t> &a,
-                 const std::tuple<int64_t, int64_t> &b) -> bool {
-                return std::get<0>(a) < std::get<0>(b);
-              });
-    for (const std::tuple<int64_t, int64_t> &value : col_vec) {
-      out_col_data[i] = std::get<0>(value);
-      out_e_id_data[i] = std::get<1>(value);
-      i += 1;
+  const auto seed = std::random_device{}(); // Initialize random seed.
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    std::mt19937 generator(seed + begin);
+    int64_t n, row_start, row_count, offset, count;
+    for (auto i = begin; i < end; i++) {
+      n = idx_data[i];
+      row_start = rowptr_data[n];
+      row_count = rowptr_data[n + 1] - row_start;
+      offset = out_rowptr_data[i];
+      count = out_rowptr_data[i + 1] - offset;
+      auto *out = out_e_id_data + offset;
+      if (count == 0)
+        continue;
+
+      sample_offsets(row_count, count, num_neighbors, replace, generator, out);
+      for (int64_t j = 0; j < count; j++)
+        out[j] += row_start;
     }
-  }
+  });
+
+  // Assign local node indices in order of appearance, starting with `idx`,
+  // and sort every row by local node index:
+  torch::Tensor out_col, out_n_id;
+  std::tie(out_col, out_n_id) =
+      relabel_sampled(idx_data, M, out_rowptr_data, out_e_id, grain_size,
+                      [&](int64_t e) { return col_data[out_e_id_data[e]]; });
 
   return std::make_tuple(out_rowptr, out_col, out_n_id, out_e_id);
 }
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <random>
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+// Shared phases of uniform neighbor sampling (`sample_adj` and its variant on
+// compressed rows): Count the sampled neighbors per row, fill in the sampled
+// offsets of every row in parallel, and relabel the sampled columns.
+
+// Neighborhoods up to this size are sampled without replacement via a partial
+// Fisher-Yates shuffle on the stack, and fan-outs up to this size are sampled
+// via Robert Floyd's algorithm without a hash set:
+#define SMALL_SAMPLE_SIZE 64
+
+// Writes `num_neighbors` distinct offsets out of `[0, row_count)` to `out`.
+inline void sample_without_replacement(int64_t row_count,
+                                       int64_t num_neighbors,
+                                       std::mt19937 &generator, int64_t *out) {
+  if (row_count <= SMALL_SAMPLE_SIZE) {
+    int64_t perm[SMALL_SAMPLE_SIZE];
+    for (int64_t j = 0; j < row_count; j++)
+      perm[j] = j;
+    for (int64_t j = 0; j < num_neighbors; j++) {
+      std::uniform_int_distribution<int64_t> dist(j, row_count - 1);
+      std::swap(perm[j], perm[dist(generator)]);
+      out[j] = perm[j];
+    }
+  } else if (num_neighbors <= SMALL_SAMPLE_SIZE) {
+    // See: https://www.nowherenearithaca.com/2013/05/
+    //      robert-floyds-tiny-and-beautiful.html
+    for (int64_t j = row_count - num_neighbors, k = 0; j < row_count;
+         j++, k++) {
+      int64_t p = std::uniform_int_distribution<int64_t>(0, j)(generator);
+      if (std::find(out, out + k, p) != out + k)
+        p = j;
+      out[k] = p;
+    }
+  } else {
+    std::unordered_set<int64_t> perm;
+    for (int64_t j = row_count - num_neighbors, k = 0; j < row_count;
+         j++, k++) {
+      int64_t p = std::uniform_int_distribution<int64_t>(0, j)(generator);
+      if (!perm.insert(p).second) {
+        p = j;
+        perm.insert(p);
+      }
+      out[k] = p;
+    }
+  }
+}
+
+// Number of neighbors sampled out of a row holding `row_count` entries.
+inline int64_t sample_count(int64_t row_count, int64_t num_neighbors,
+                            bool replace) {
+  if (num_neighbors < 0)
+    return row_count;
+  if (replace)
+    return row_count > 0 ? num_neighbors : 0;
+  return std::min(row_count, num_neighbors);
+}
+
+// Writes `count` sampled offsets out of `[0, row_count)` to `out`.
+inline void sample_offsets(int64_t row_count, int64_t count,
+                           int64_t num_neighbors, bool replace,
+                           std::mt19937 &generator, int64_t *out) {
+  if (count == row_count && (num_neighbors < 0 || !replace)) {
+    for (int64_t j = 0; j < count; j++)
+      out[j] = j;
+  } else if (replace) {
+    std::uniform_int_distribution<int64_t> dist(0, row_count - 1);
+    for (int64_t j = 0; j < count; j++)
+      out[j] = dist(generator);
+  } else {
+    sample_without_replacement(row_count, count, generator, out);
+  }
+}
+
+// Assigns local node indices to the sampled columns in order of appearance,
+// starting with `idx`, and sorts every row by local node index.
+// `col_of(e)` returns the global column of the `e`-th sampled entry, and
+// `out_e_id` is permuted along. Returns `col` and `n_id`.
+template <typename col_fn_t>
+inline std::tuple<torch::Tensor, torch::Tensor>
+relabel_sampled(const int64_t *idx_data, int64_t M,
+                const int64_t *out_rowptr_data, torch::Tensor out_e_id,
+                int64_t grain_size, col_fn_t col_of) {
+  const auto E = out_rowptr_data[M];
+  auto out_e_id_data = out_e_id.data_ptr<int64_t>();
+
+  std::vector<int64_t> n_ids(idx_data, idx_data + M);
+  std::unordered_map<int64_t, int64_t> n_id_map;
+  n_id_map.reserve(M + E);
+  for (int64_t i = 0; i < M; i++)
+    n_id_map[idx_data[i]] = i;
+
+  std::vector<std::pair<int64_t, int64_t>> cols(E); // col, e_id
+  for (int64_t e = 0; e < E; e++) {
+    const auto c = col_of(e);
+    const auto res = n_id_map.insert({c, (int64_t)n_ids.size()});
+    if (res.second)
+      n_ids.push_back(c);
+    cols[e] = {res.first->second, out_e_id_data[e]};
+  }
+
+  int64_t N = n_ids.size();
+  auto out_n_id =
+      torch::from_blob(n_ids.data(), {N}, out_e_id.options()).clone();
+
+  auto out_col = torch::empty(E, out_e_id.options());
+  auto out_col_data = out_col.data_ptr<int64_t>();
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    for (auto i = begin; i < end; i++) {
+      const auto row_start = out_rowptr_data[i];
+      const auto row_end = out_rowptr_data[i + 1];
+      std::sort(cols.begin() + row_start, cols.begin() + row_end,
+                [](const std::pair<int64_t, int64_t> &a,
+                   const std::pair<int64_t, int64_t> &b) -> bool {
+                  return a.first < b.first;
+                });
+      for (auto e = row_start; e < row_end; e++) {
+        out_col_data[e] = cols[e].first;
+        out_e_id_data[e] = cols[e].second;
+      }
+    }
+  });
+
+  return std::make_tuple(out_col, out_n_id);
+}
@@ -0,0 +1,204 @@
+#include "sell_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+// Converts a CSR matrix into the SELL-C-sigma format: Rows are sorted by
+// decreasing length within windows of `sigma` rows and packed into chunks of
+// `chunk_size` consecutive rows, each of which is padded to the length of
+// its longest row. Entries of a chunk are stored column-major, i.e., the
+// `j`-th entry of lane `l` in chunk `c` lives at `chunkptr[c] + j * C + l`.
+// Returns the row order `perm`, the chunk pointer, the packed column indices
+// and the packed permutation into the CSR entries (`-1` denotes padding).
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+to_sell_cpu(torch::Tensor rowptr, torch::Tensor col, int64_t chunk_size,
+            int64_t sigma) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(chunk_size > 0 && sigma > 0);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+  auto C = chunk_size;
+
+  auto perm = torch::arange(M, rowptr.options());
+  auto perm_data = perm.data_ptr<int64_t>();
+
+  auto num_windows = (M + sigma - 1) / sigma;
+  at::parallel_for(0, num_windows, 1, [&](int64_t begin, int64_t end) {
+    for (auto w = begin; w < end; w++) {
+      std::stable_sort(perm_data + w * sigma,
+                       perm_data + std::min((w + 1) * sigma, M),
+                       [&](const int64_t &a, const int64_t &b) {
+                         return rowptr_data[a + 1] - rowptr_data[a] >
+                                rowptr_data[b + 1] - rowptr_data[b];
+                       });
+    }
+  });
+
+  auto num_chunks = (M + C - 1) / C;
+  auto chunkptr = torch::empty(num_chunks + 1, rowptr.options());
+  auto chunkptr_data = chunkptr.data_ptr<int64_t>();
+
+  chunkptr_data[0] = 0;
+  for (int64_t c = 0; c < num_chunks; c++) {
+    int64_t width = 0;
+    for (auto i = c * C; i < std::min((c + 1) * C, M); i++) {
+      auto r = perm_data[i];
+      width = std::max(width, rowptr_data[r + 1] - rowptr_data[r]);
+    }
+    chunkptr_data[c + 1] = chunkptr_data[c] + width * C;
+  }
+
+  // Padding entries are marked by `eperm == -1` and hold zero values once
+  // packed. Their column is set to zero to keep it a valid index:
+  auto out_col = torch::zeros(chunkptr_data[num_chunks], col.options());
+  auto out_eperm = torch::full(chunkptr_data[num_chunks], -1, col.options());
+  auto out_col_data = out_col.data_ptr<int64_t>();
+  auto out_eperm_data = out_eperm.data_ptr<int64_t>();
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (auto c = begin; c < end; c++) {
+      for (auto l = 0; l < C && c * C + l < M; l++) {
+        auto r = perm_data[c * C + l];
+        auto row_start = rowptr_data[r];
+        for (auto e = row_start; e < rowptr_data[r + 1]; e++) {
+          auto pos = chunkptr_data[c] + (e - row_start) * C + l;
+          out_col_data[pos] = col_data[e];
+          out_eperm_data[pos] = e;
+        }
+      }
+    }
+  });
+
+  return std::make_tuple(perm, chunkptr, out_col, out_eperm);
+}
+
+// Feature dimensions up to this size are processed lane-wise, i.e., with the
+// loop over the `C` rows of a chunk innermost. Larger ones iterate over
+// features innermost, which already vectorizes along contiguous rows of
+// `mat`:
+#define SELL_LANE_WISE_K 16
+
+// Sum-reduces a SELL-C-sigma matrix with `mat` of shape `[*, N, K]`, given
+// the values `value` in packed order (see `SparseStorage.sell_value`), in
+// which padding entries hold zeros. All `C` rows of a chunk are processed in
+// lockstep, i.e., the `j`-th entries of every lane are consumed before
+// moving to the `j + 1`-th ones, so that the packed index and value streams
+// are read contiguously. Padding does not need any branching, since it
+// contributes zeros.
+torch::Tensor sell_spmm_cpu(torch::Tensor perm, torch::Tensor chunkptr,
+                            torch::Tensor col, torch::Tensor value,
+                            torch::Tensor mat, int64_t chunk_size) {
+  CHECK_CPU(perm);
+  CHECK_CPU(chunkptr);
+  CHECK_CPU(col);
+  CHECK_CPU(value);
+  CHECK_CPU(mat);
+
+  CHECK_INPUT(perm.dim() == 1);
+  CHECK_INPUT(chunkptr.dim() == 1);
+  CHECK_INPUT(value.dim() == 1);
+  CHECK_INPUT(col.numel() == value.numel());
+  CHECK_INPUT(chunk_size > 0);
+  CHECK_INPUT(chunkptr.numel() - 1 ==
+              (perm.numel() + chunk_size - 1) / chunk_size);
+  CHECK_INPUT(mat.dim() >= 2);
+  CHECK_INPUT(value.scalar_type() == mat.scalar_type());
+
+  mat = mat.contiguous(), value = value.contiguous();
+
+  auto M = perm.numel();
+  auto N = mat.size(-2);
+  auto K = mat.size(-1);
+  auto B = mat.numel() / (N * K);
+  auto num_chunks = chunkptr.numel() - 1;
+  auto C = chunk_size;
+
+  auto sizes = mat.sizes().vec();
+  sizes[mat.dim() - 2] = M;
+  auto out = torch::empty(sizes, mat.options());
+
+  auto perm_data = perm.data_ptr<int64_t>();
+  auto chunkptr_data = chunkptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, mat.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto value_data = value.data_ptr<scalar_t>();
+        auto mat_data = mat.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+
+        int64_t grain_size =
+            at::internal::GRAIN_SIZE /
+            (C * K *
+             std::max(col.numel() / std::max(M, (int64_t)1), (int64_t)1));
+        at::parallel_for(
+            0, B * num_chunks, std::max(grain_size, (int64_t)1),
+            [&](int64_t begin, int64_t end) {
+              // Accumulators of shape `[K, C]` (lane-wise) or `[C, K]`:
+              std::vector<acc_t> vals(C * K);
+              int64_t b, c, lanes, width, pos;
+
+              for (auto i = begin; i < end; i++) {
+                b = i / num_chunks, c = i % num_chunks;
+
+                width = (chunkptr_data[c + 1] - chunkptr_data[c]) / C;
+                lanes = std::min(C, M - c * C);
+
+                std::fill(vals.begin(), vals.end(), (acc_t)0);
+
+                auto mat_batch = mat_data + b * N * K;
+                if (K <= SELL_LANE_WISE_K) {
+                  for (int64_t j = 0; j < width; j++) {
+                    pos = chunkptr_data[c] + j * C;
+                    const auto *col_lane = col_data + pos;
+                    const auto *value_lane = value_data + pos;
+                    for (int64_t k = 0; k < K; k++) {
+                      auto vals_k = vals.data() + k * C;
+                      for (int64_t l = 0; l < C; l++)
+                        vals_k[l] += (acc_t)value_lane[l] *
+                                     (acc_t)mat_batch[col_lane[l] * K + k];
+                    }
+                  }
+                  for (int64_t l = 0; l < lanes; l++) {
+                    auto out_row =
+                        out_data + (b * M + perm_data[c * C + l]) * K;
+                    for (int64_t k = 0; k < K; k++)
+                      out_row[k] = (scalar_t)vals[k * C + l];
+                  }
+
+                } else {
+                  for (int64_t j = 0; j < width; j++) {
+                    pos = chunkptr_data[c] + j * C;
+                    for (int64_t l = 0; l < C; l++) {
+                      const auto val = (acc_t)value_data[pos + l];
+                      auto mat_row = mat_batch + col_data[pos + l] * K;
+                      auto vals_row = vals.data() + l * K;
+                      for (int64_t k = 0; k < K; k++)
+                        vals_row[k] += val * (acc_t)mat_row[k];
+                    }
+                  }
+                  for (int64_t l = 0; l < lanes; l++) {
+                    auto out_row =
+                        out_data + (b * M + perm_data[c * C + l]) * K;
+                    auto vals_row = vals.data() + l * K;
+                    for (int64_t k = 0; k < K; k++)
+                      out_row[k] = (scalar_t)vals_row[k];
+                  }
+                }
+              }
+            });
+      });
+
+  return out;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+to_sell_cpu(torch::Tensor rowptr, torch::Tensor col, int64_t chunk_size,
+            int64_t sigma);
+
+torch::Tensor sell_spmm_cpu(torch::Tensor perm, torch::Tensor chunkptr,
+                            torch::Tensor col, torch::Tensor value,
+                            torch::Tensor mat, int64_t chunk_size);
@@ -0,0 +1,128 @@
+#include "softmax_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include "utils.h"
+
+torch::Tensor softmax_fw_cpu(torch::Tensor rowptr, torch::Tensor value,
+                             bool inplace) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(value);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(value.dim() == 1 || value.dim() == 2);
+  if (inplace)
+    CHECK_INPUT(value.is_contiguous());
+
+  value = value.contiguous();
+  auto out = inplace ? value : torch::empty_like(value);
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+
+  auto M = rowptr.numel() - 1;
+  auto H = value.dim() == 2 ? value.size(1) : 1;
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, value.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto value_data = value.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+
+        int64_t avg_degree = std::max(
+            value.size(0) / std::max(M, (int64_t)1), (int64_t)1);
+        int64_t grain_size = at::internal::GRAIN_SIZE / (H * avg_degree);
+        at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+          std::vector<acc_t> maxs(H), sums(H);
+          acc_t val;
+          int64_t row_start, row_end;
+
+          for (auto m = begin; m < end; m++) {
+            row_start = rowptr_data[m], row_end = rowptr_data[m + 1];
+
+            // Compute running maximum and normalizer in a single pass, see:
+            // https://arxiv.org/abs/1805.02867
+            for (auto h = 0; h < H; h++) {
+              maxs[h] = -std::numeric_limits<acc_t>::infinity();
+              sums[h] = (acc_t)0;
+            }
+            for (auto e = row_start; e < row_end; e++) {
+              for (auto h = 0; h < H; h++) {
+                val = (acc_t)value_data[e * H + h];
+                if (val > maxs[h]) {
+                  sums[h] = sums[h] * std::exp(maxs[h] - val) + (acc_t)1;
+                  maxs[h] = val;
+                } else {
+                  sums[h] += std::exp(val - maxs[h]);
+                }
+              }
+            }
+
+            for (auto e = row_start; e < row_end; e++) {
+              for (auto h = 0; h < H; h++) {
+                val = (acc_t)value_data[e * H + h];
+                out_data[e * H + h] =
+                    (scalar_t)(std::exp(val - maxs[h]) / sums[h]);
+              }
+            }
+          }
+        });
+      });
+
+  return out;
+}
+
+torch::Tensor softmax_bw_cpu(torch::Tensor rowptr, torch::Tensor out,
+                             torch::Tensor grad_out) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(out);
+  CHECK_CPU(grad_out);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(out.sizes() == grad_out.sizes());
+
+  out = out.contiguous();
+  grad_out = grad_out.contiguous();
+  auto grad_value = torch::empty_like(out);
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+
+  auto M = rowptr.numel() - 1;
+  auto H = out.dim() == 2 ? out.size(1) : 1;
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, out.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto out_data = out.data_ptr<scalar_t>();
+        auto grad_out_data = grad_out.data_ptr<scalar_t>();
+        auto grad_value_data = grad_value.data_ptr<scalar_t>();
+
+        int64_t avg_degree =
+            std::max(out.size(0) / std::max(M, (int64_t)1), (int64_t)1);
+        int64_t grain_size = at::internal::GRAIN_SIZE / (H * avg_degree);
+        at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+          std::vector<acc_t> dots(H);
+          int64_t row_start, row_end;
+
+          for (auto m = begin; m < end; m++) {
+            row_start = rowptr_data[m], row_end = rowptr_data[m + 1];
+
+            for (auto h = 0; h < H; h++)
+              dots[h] = (acc_t)0;
+            for (auto e = row_start; e < row_end; e++)
+              for (auto h = 0; h < H; h++)
+                dots[h] += (acc_t)out_data[e * H + h] *
+                           (acc_t)grad_out_data[e * H + h];
+
+            for (auto e = row_start; e < row_end; e++)
+              for (auto h = 0; h < H; h++)
+                grad_value_data[e * H + h] = (scalar_t)(
+                    (acc_t)out_data[e * H + h] *
+                    ((acc_t)grad_out_data[e * H + h] - dots[h]));
+          }
+        });
+      });
+
+  return grad_value;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../extensions.h"
+
+torch::Tensor softmax_fw_cpu(torch::Tensor rowptr, torch::Tensor value,
+                             bool inplace);
+
+torch::Tensor softmax_bw_cpu(torch::Tensor rowptr, torch::Tensor out,
+                             torch::Tensor grad_out);
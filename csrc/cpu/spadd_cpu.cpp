@@ -0,0 +1,317 @@
+#include "spadd_cpu.h"
+
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "utils.h"
+
+// Computes the sparsity pattern of `A + B` by merging the (column-sorted)
+// rows of both CSR matrices, which avoids concatenating and re-sorting all
+// indices. Duplicate entries inside `A` or `B` are coalesced as well.
+// Besides the output CSR pattern, it returns the output position of every
+// non-zero entry in `A` and `B`, so that values can be reduced afterwards
+// (in a differentiable way) via `index_add` or `scatter`.
+static std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                  torch::Tensor>
+csr_merge(torch::Tensor rowptrA, torch::Tensor colA, torch::Tensor rowptrB,
+          torch::Tensor colB) {
+  auto rowptrA_data = rowptrA.data_ptr<int64_t>();
+  auto colA_data = colA.data_ptr<int64_t>();
+  auto rowptrB_data = rowptrB.data_ptr<int64_t>();
+  auto colB_data = colB.data_ptr<int64_t>();
+
+  // Rows that only exist in one of both matrices are treated as empty:
+  auto MA = rowptrA.numel() - 1, MB = rowptrB.numel() - 1;
+  auto M = std::max(MA, MB);
+
+  auto row_range = [&](const int64_t *rowptr_data, int64_t rows, int64_t m,
+                       int64_t &row_start, int64_t &row_end) {
+    row_start = m < rows ? rowptr_data[m] : 0;
+    row_end = m < rows ? rowptr_data[m + 1] : 0;
+  };
+
+  // Runs a two-pointer merge over row `m` and calls
+  // `emit(from_a, e, c, is_new)` for every entry `e` in merged order, where
+  // `is_new` denotes whether column `c` differs from the previous one:
+  auto merge = [&](int64_t m, auto emit) {
+    int64_t a, a_end, b, b_end, c, last = -1;
+    row_range(rowptrA_data, MA, m, a, a_end);
+    row_range(rowptrB_data, MB, m, b, b_end);
+    while (a < a_end || b < b_end) {
+      bool take_a = b >= b_end || (a < a_end && colA_data[a] <= colB_data[b]);
+      c = take_a ? colA_data[a] : colB_data[b];
+      emit(take_a, take_a ? a++ : b++, c, c != last);
+      last = c;
+    }
+  };
+
+  int64_t avg_degree = std::max(
+      (colA.numel() + colB.numel()) / std::max(M, (int64_t)1), (int64_t)1);
+  int64_t grain_size = at::internal::GRAIN_SIZE / avg_degree;
+
+  // Symbolic pass: Count the number of unique columns per output row.
+  auto rowptr = torch::zeros(M + 1, rowptrA.options());
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    for (auto m = begin; m < end; m++) {
+      int64_t count = 0;
+      merge(m, [&](bool, int64_t, int64_t, bool is_new) { count += is_new; });
+      rowptr_data[m + 1] = count;
+    }
+  });
+  rowptr = rowptr.cumsum(0);
+  rowptr_data = rowptr.data_ptr<int64_t>();
+
+  // Numeric pass: Write output columns and the positions of input entries.
+  auto col = torch::empty(rowptr_data[M], colA.options());
+  auto permA = torch::empty(colA.numel(), colA.options());
+  auto permB = torch::empty(colB.numel(), colB.options());
+  auto col_data = col.data_ptr<int64_t>();
+  auto permA_data = permA.data_ptr<int64_t>();
+  auto permB_data = permB.data_ptr<int64_t>();
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    for (auto m = begin; m < end; m++) {
+      int64_t offset = rowptr_data[m] - 1;
+      merge(m, [&](bool from_a, int64_t e, int64_t c, bool is_new) {
+        if (is_new)
+          col_data[++offset] = c;
+        if (from_a)
+          permA_data[e] = offset;
+        else
+          permB_data[e] = offset;
+      });
+    }
+  });
+
+  return std::make_tuple(rowptr, col, permA, permB);
+}
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+spadd_cpu(torch::Tensor rowptrA, torch::Tensor colA, torch::Tensor rowptrB,
+          torch::Tensor colB) {
+  CHECK_CPU(rowptrA);
+  CHECK_CPU(colA);
+  CHECK_CPU(rowptrB);
+  CHECK_CPU(colB);
+
+  CHECK_INPUT(rowptrA.dim() == 1);
+  CHECK_INPUT(colA.dim() == 1);
+  CHECK_INPUT(rowptrB.dim() == 1);
+  CHECK_INPUT(colB.dim() == 1);
+
+  return csr_merge(rowptrA.contiguous(), colA.contiguous(),
+                   rowptrB.contiguous(), colB.contiguous());
+}
+
+// Symmetrizes a (row-sorted) CSR matrix by merging each row of `A` with the
+// matching row of `A^T`. The transpose is obtained via a counting sort,
+// which keeps the column-sorted order of rows in `A^T` without the need to
+// sort any indices. Rows are split into chunks of roughly equal numbers of
+// edges, each of which counts its columns into its own histogram, so that
+// both the counting and the scatter pass run in parallel. In case `colptr`
+// and `csr2csc` of `A` are already known, the transpose is gathered instead.
+// Returns the output pattern of shape `[N, N]`, the permutation `csr2csc`
+// that maps `A` values to `A^T` values, and the output positions of all
+// entries in `A` and `A^T`.
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+           torch::Tensor>
+to_symmetric_cpu(torch::Tensor rowptr, torch::Tensor col, int64_t N,
+                 torch::optional<torch::Tensor> optional_colptr,
+                 torch::optional<torch::Tensor> optional_csr2csc) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(rowptr.numel() - 1 <= N);
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+  auto E = col.numel();
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(E / std::max(M, (int64_t)1), (int64_t)1);
+
+  torch::Tensor colptr, csr2csc;
+  auto row_t = torch::empty(E, col.options());
+  auto row_t_data = row_t.data_ptr<int64_t>();
+
+  if (optional_colptr.has_value() && optional_csr2csc.has_value()) {
+    colptr = optional_colptr.value().contiguous();
+    csr2csc = optional_csr2csc.value().contiguous();
+    CHECK_CPU(colptr);
+    CHECK_CPU(csr2csc);
+    CHECK_INPUT(colptr.numel() - 1 <= N);
+    CHECK_INPUT(csr2csc.numel() == E);
+
+    // Expand `rowptr` into rows, and gather them in column-major order:
+    auto row = torch::empty(E, col.options());
+    auto row_data = row.data_ptr<int64_t>();
+    at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+      for (auto m = begin; m < end; m++)
+        std::fill(row_data + rowptr_data[m], row_data + rowptr_data[m + 1], m);
+    });
+    auto csr2csc_data = csr2csc.data_ptr<int64_t>();
+    at::parallel_for(0, E, at::internal::GRAIN_SIZE, [&](int64_t b, int64_t e) {
+      for (auto pos = b; pos < e; pos++)
+        row_t_data[pos] = row_data[csr2csc_data[pos]];
+    });
+
+  } else {
+    // Histograms of all chunks should not take more memory than the edges:
+    const int64_t num_chunks =
+        std::max(std::min((int64_t)at::get_num_threads(),
+                          E / std::max(N, (int64_t)1)),
+                 (int64_t)1);
+    std::vector<int64_t> chunk_ptr(num_chunks + 1, M);
+    chunk_ptr[0] = 0;
+    for (int64_t t = 1; t < num_chunks; t++)
+      chunk_ptr[t] = std::upper_bound(rowptr_data, rowptr_data + M,
+                                      t * E / num_chunks) -
+                     rowptr_data - 1;
+
+    std::vector<int64_t> hist(num_chunks * N, 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (auto t = begin; t < end; t++) {
+        auto *h = hist.data() + t * N;
+        for (auto e = rowptr_data[chunk_ptr[t]];
+             e < rowptr_data[chunk_ptr[t + 1]]; e++)
+          h[col_data[e]]++;
+      }
+    });
+
+    colptr = torch::empty(N + 1, rowptr.options());
+    auto colptr_data = colptr.data_ptr<int64_t>();
+    colptr_data[0] = 0;
+    at::parallel_for(0, N, at::internal::GRAIN_SIZE, [&](int64_t b, int64_t e) {
+      for (auto c = b; c < e; c++) {
+        int64_t count = 0;
+        for (int64_t t = 0; t < num_chunks; t++)
+          count += hist[t * N + c];
+        colptr_data[c + 1] = count;
+      }
+    });
+    colptr = colptr.cumsum(0);
+    colptr_data = colptr.data_ptr<int64_t>();
+
+    // Turn per-chunk counts into per-chunk write offsets of every column:
+    at::parallel_for(0, N, at::internal::GRAIN_SIZE, [&](int64_t b, int64_t e) {
+      for (auto c = b; c < e; c++) {
+        int64_t offset = colptr_data[c], count;
+        for (int64_t t = 0; t < num_chunks; t++) {
+          count = hist[t * N + c];
+          hist[t * N + c] = offset;
+          offset += count;
+        }
+      }
+    });
+
+    csr2csc = torch::empty(E, col.options());
+    auto csr2csc_data = csr2csc.data_ptr<int64_t>();
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      int64_t pos;
+      for (auto t = begin; t < end; t++) {
+        auto *cursor = hist.data() + t * N;
+        for (auto m = chunk_ptr[t]; m < chunk_ptr[t + 1]; m++) {
+          for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+            pos = cursor[col_data[e]]++;
+            row_t_data[pos] = m;
+            csr2csc_data[pos] = e;
+          }
+        }
+      }
+    });
+  }
+
+  auto result = csr_merge(rowptr, col, colptr, row_t);
+  return std::make_tuple(std::get<0>(result), std::get<1>(result), csr2csc,
+                         std::get<2>(result), std::get<3>(result));
+}
+
+// Checks whether a (row-sorted) CSR matrix is symmetric by looking up the
+// transposed entry of every non-zero via a binary search in its column's
+// row, which avoids materializing the CSC representation.
+bool is_symmetric_cpu(torch::Tensor rowptr, torch::Tensor col,
+                      torch::optional<torch::Tensor> optional_value) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  if (optional_value.has_value())
+    CHECK_CPU(optional_value.value());
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  if (optional_value.has_value())
+    CHECK_INPUT(optional_value.value().size(0) == col.numel());
+
+  rowptr = rowptr.contiguous(), col = col.contiguous();
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+  auto M = rowptr.numel() - 1;
+
+  // Non-square matrices can not be symmetric:
+  if (col.numel() > 0 && col.max().item<int64_t>() >= M)
+    return false;
+
+  std::atomic<bool> symmetric(true);
+
+  // Returns the range of entries in row `m` that point to column `c`:
+  auto equal_range = [&](int64_t m, int64_t c) {
+    if (m >= M)
+      return std::make_pair((int64_t)0, (int64_t)0);
+    auto range = std::equal_range(col_data + rowptr_data[m],
+                                  col_data + rowptr_data[m + 1], c);
+    return std::make_pair((int64_t)(range.first - col_data),
+                          (int64_t)(range.second - col_data));
+  };
+
+  int64_t grain_size = at::internal::GRAIN_SIZE /
+                       std::max(col.numel() / std::max(M, (int64_t)1),
+                                (int64_t)1);
+  at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+    for (auto m = begin; m < end && symmetric; m++) {
+      for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+        auto c = col_data[e];
+        auto range = equal_range(m, c), range_t = equal_range(c, m);
+        if (range.second - range.first != range_t.second - range_t.first) {
+          symmetric = false;
+          break;
+        }
+      }
+    }
+  });
+
+  if (!symmetric || !optional_value.has_value())
+    return symmetric;
+
+  auto value = optional_value.value().contiguous();
+  auto D = value.numel() / std::max(col.numel(), (int64_t)1);
+
+  AT_DISPATCH_ALL_TYPES_AND3(
+      at::ScalarType::Half, at::ScalarType::BFloat16, at::ScalarType::Bool,
+      value.scalar_type(), "_", [&] {
+        auto value_data = value.data_ptr<scalar_t>();
+        at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+          for (auto m = begin; m < end && symmetric; m++) {
+            for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+              auto c = col_data[e];
+              // Duplicated entries are compared position-wise:
+              auto e_t = equal_range(c, m).first + e - equal_range(m, c).first;
+              for (auto d = 0; d < D; d++) {
+                if (value_data[e * D + d] != value_data[e_t * D + d]) {
+                  symmetric = false;
+                  break;
+                }
+              }
+            }
+          }
+        });
+      });
+
+  return symmetric;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../extensions.h"
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+spadd_cpu(torch::Tensor rowptrA, torch::Tensor colA, torch::Tensor rowptrB,
+          torch::Tensor colB);
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+           torch::Tensor>
+to_symmetric_cpu(torch::Tensor rowptr, torch::Tensor col, int64_t N,
+                 torch::optional<torch::Tensor> optional_colptr,
+                 torch::optional<torch::Tensor> optional_csr2csc);
+
+bool is_symmetric_cpu(torch::Tensor rowptr, torch::Tensor col,
+                      torch::optional<torch::Tensor> optional_value);
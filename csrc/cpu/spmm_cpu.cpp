@@ -5,6 +5,9 @@
 #include "reducer.h"
 #include "utils.h"
 
+// In case `optional_value` holds multi-head edge weights of shape `[nnz, H]`,
+// `mat` is expected to be of shape `[*, N, H, K]`, and every head gets
+// reduced with its own weights in a single traversal of the CSR structure.
 std::tuple<torch::Tensor, torch::optional<torch::Tensor>>
 spmm_cpu(torch::Tensor rowptr, torch::Tensor col,
          torch::optional<torch::Tensor> optional_value, torch::Tensor mat,
@@ -17,16 +20,29 @@ spmm_cpu(torch::Tensor rowptr, torch::Tensor col,
 
   CHECK_INPUT(rowptr.dim() == 1);
   CHECK_INPUT(col.dim() == 1);
+  int64_t H = 1;
   if (optional_value.has_value()) {
-    CHECK_INPUT(optional_value.value().dim() == 1);
+    CHECK_INPUT(optional_value.value().dim() <= 2);
     CHECK_INPUT(optional_value.value().size(0) == col.size(0));
+    if (optional_value.value().dim() == 2) {
+      H = optional_value.value().size(1);
+      CHECK_INPUT(mat.dim() >= 3);
+      CHECK_INPUT(mat.size(-2) == H);
+      optional_value = optional_value.value().contiguous();
+    }
   }
   CHECK_INPUT(mat.dim() >= 2);
 
   mat = mat.contiguous();
 
+  // Multi-head features are laid out as `[*, N, H, K]`:
+  auto node_dim = optional_value.has_value() &&
+                          optional_value.value().dim() == 2
+                      ? mat.dim() - 3
+                      : mat.dim() - 2;
+
   auto sizes = mat.sizes().vec();
-  sizes[mat.dim() - 2] = rowptr.numel() - 1;
+  sizes[node_dim] = rowptr.numel() - 1;
   auto out = torch::empty(sizes, mat.options());
 
   torch::optional<torch::Tensor> arg_out = torch::nullopt;
@@ -40,69 +56,85 @@ spmm_cpu(torch::Tensor rowptr, torch::Tensor col,
   auto col_data = col.data_ptr<int64_t>();
 
   auto M = rowptr.numel() - 1;
-  auto N = mat.size(-2);
+  auto N = mat.size(node_dim);
   auto K = mat.size(-1);
-  auto B = mat.numel() / (N * K);
-
-  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Half, mat.scalar_type(), "_", [&] {
-    scalar_t *value_data = nullptr;
-    auto mat_data = mat.data_ptr<scalar_t>();
-    auto out_data = out.data_ptr<scalar_t>();
-
-    AT_DISPATCH_REDUCTION_TYPES(reduce, [&] {
-      AT_DISPATCH_HAS_VALUE(optional_value, [&] {
-        if (HAS_VALUE) {
-          value_data = optional_value.value().data_ptr<scalar_t>();
-        }
-
-        int64_t grain_size = at::internal::GRAIN_SIZE /
-                             (K * std::max(col.numel() / M, (int64_t)1));
-        at::parallel_for(0, B * M, grain_size, [&](int64_t begin, int64_t end) {
-          scalar_t val;
-          std::vector<scalar_t> vals(K);
-          int64_t row_start, row_end, b, m, c;
-          std::vector<int64_t> args(K);
-
-          for (auto i = begin; i < end; i++) {
-            b = i / M, m = i % M;
+  auto B = mat.numel() / (N * H * K);
 
-            row_start = rowptr_data[m], row_end = rowptr_data[m + 1];
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, mat.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        scalar_t *value_data = nullptr;
+        auto mat_data = mat.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
 
-            for (auto k = 0; k < K; k++)
-              vals[k] = Reducer<scalar_t, REDUCE>::init();
-
-            auto offset = b * N * K;
-            for (auto e = row_start; e < row_end; e++) {
-              c = col_data[e];
-              if (HAS_VALUE)
-                val = value_data[e];
-              for (auto k = 0; k < K; k++) {
-                if (HAS_VALUE)
-                  Reducer<scalar_t, REDUCE>::update(
-                      &vals[k], val * mat_data[offset + c * K + k], &args[k],
-                      e);
-                else
-                  Reducer<scalar_t, REDUCE>::update(
-                      &vals[k], mat_data[offset + c * K + k], &args[k], e);
-              }
+        AT_DISPATCH_REDUCTION_TYPES(reduce, [&] {
+          AT_DISPATCH_HAS_VALUE(optional_value, [&] {
+            if (HAS_VALUE) {
+              value_data = optional_value.value().data_ptr<scalar_t>();
             }
-            offset = b * M * K + m * K;
-            for (auto k = 0; k < K; k++)
-              Reducer<scalar_t, REDUCE>::write(out_data + offset + k, vals[k],
-                                               arg_out_data + offset + k,
-                                               args[k], row_end - row_start);
-          }
+
+            int64_t grain_size =
+                at::internal::GRAIN_SIZE /
+                (H * K * std::max(col.numel() / std::max(M, (int64_t)1),
+                                  (int64_t)1));
+            at::parallel_for(
+                0, B * M, grain_size, [&](int64_t begin, int64_t end) {
+                  acc_t val;
+                  std::vector<acc_t> vals(H * K);
+                  int64_t row_start, row_end, b, m, c;
+                  std::vector<int64_t> args(H * K);
+
+                  for (auto i = begin; i < end; i++) {
+                    b = i / M, m = i % M;
+
+                    row_start = rowptr_data[m], row_end = rowptr_data[m + 1];
+
+                    for (auto k = 0; k < H * K; k++)
+                      vals[k] = Reducer<acc_t, REDUCE>::init();
+
+                    auto offset = b * N * H * K;
+                    for (auto e = row_start; e < row_end; e++) {
+                      c = col_data[e];
+                      for (auto h = 0; h < H; h++) {
+                        if (HAS_VALUE)
+                          val = (acc_t)value_data[e * H + h];
+                        auto mat_row = mat_data + offset + (c * H + h) * K;
+                        auto vals_row = vals.data() + h * K;
+                        auto args_row = args.data() + h * K;
+                        for (auto k = 0; k < K; k++) {
+                          if (HAS_VALUE)
+                            Reducer<acc_t, REDUCE>::update(
+                                &vals_row[k], val * (acc_t)mat_row[k],
+                                &args_row[k], e);
+                          else
+                            Reducer<acc_t, REDUCE>::update(
+                                &vals_row[k], (acc_t)mat_row[k], &args_row[k],
+                                e);
+                        }
+                      }
+                    }
+                    offset = (b * M + m) * H * K;
+                    for (auto k = 0; k < H * K; k++)
+                      Reducer<acc_t, REDUCE>::write(
+                          out_data + offset + k, vals[k],
+                          arg_out_data + offset + k, args[k],
+                          row_end - row_start);
+                  }
+                });
+          });
         });
       });
-    });
-  });
 
   return std::make_tuple(out, arg_out);
 }
 
+// Returns the gradient w.r.t. `value`, which is of shape `[nnz, H]` in case
+// `multi_head` is set (with `mat` and `grad` of shape `[*, N, H, K]`).
 torch::Tensor spmm_value_bw_cpu(torch::Tensor row, torch::Tensor rowptr,
                                 torch::Tensor col, torch::Tensor mat,
-                                torch::Tensor grad, std::string reduce) {
+                                torch::Tensor grad, std::string reduce,
+                                bool multi_head) {
   CHECK_CPU(row);
   CHECK_CPU(rowptr);
   CHECK_CPU(col);
@@ -112,41 +144,330 @@ torch::Tensor spmm_value_bw_cpu(torch::Tensor row, torch::Tensor rowptr,
   mat = mat.contiguous();
   grad = grad.contiguous();
 
-  auto M = grad.size(-2);
-  auto N = mat.size(-2);
+  auto H = multi_head ? mat.size(-2) : 1;
+  auto M = grad.size(multi_head ? -3 : -2);
+  auto N = mat.size(multi_head ? -3 : -2);
   auto E = row.numel();
   auto K = mat.size(-1);
-  auto B = mat.numel() / (N * K);
+  auto B = mat.numel() / (N * H * K);
 
-  auto out = torch::zeros(row.numel(), grad.options());
+  auto out = multi_head ? torch::empty({E, H}, grad.options())
+                        : torch::empty(E, grad.options());
 
   auto row_data = row.data_ptr<int64_t>();
   auto rowptr_data = rowptr.data_ptr<int64_t>();
   auto col_data = col.data_ptr<int64_t>();
-  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Half, mat.scalar_type(), "_", [&] {
-    auto mat_data = mat.data_ptr<scalar_t>();
-    auto grad_data = grad.data_ptr<scalar_t>();
-    auto out_data = out.data_ptr<scalar_t>();
-
-    scalar_t val;
-    int64_t row, col;
-    AT_DISPATCH_REDUCTION_TYPES(reduce, [&] {
-      for (int b = 0; b < B; b++) {
-        for (int e = 0; e < E; e++) {
-          row = row_data[e], col = col_data[e], val = (scalar_t)0;
-          for (int k = 0; k < K; k++) {
-            val += mat_data[b * N * K + col * K + k] *
-                   grad_data[b * M * K + row * K + k];
-          }
-          if (REDUCE == MEAN) {
-            int row_start = rowptr_data[row], row_end = rowptr_data[row + 1];
-            val /= (scalar_t)std::max(row_end - row_start, 1);
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, mat.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto mat_data = mat.data_ptr<scalar_t>();
+        auto grad_data = grad.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+
+        AT_DISPATCH_REDUCTION_TYPES(reduce, [&] {
+          // Every edge writes to its own output, so we can parallelize over
+          // edges without any synchronization:
+          int64_t grain_size =
+              at::internal::GRAIN_SIZE / std::max(B * H * K, (int64_t)1);
+          at::parallel_for(0, E, grain_size, [&](int64_t begin, int64_t end) {
+            acc_t val;
+            int64_t row, col;
+            for (auto e = begin; e < end; e++) {
+              row = row_data[e], col = col_data[e];
+              for (auto h = 0; h < H; h++) {
+                val = (acc_t)0;
+                for (auto b = 0; b < B; b++) {
+                  auto mat_row = mat_data + ((b * N + col) * H + h) * K;
+                  auto grad_row = grad_data + ((b * M + row) * H + h) * K;
+                  for (auto k = 0; k < K; k++)
+                    val += (acc_t)mat_row[k] * (acc_t)grad_row[k];
+                }
+                if (REDUCE == MEAN) {
+                  auto row_start = rowptr_data[row],
+                       row_end = rowptr_data[row + 1];
+                  val /= (acc_t)std::max(row_end - row_start, (int64_t)1);
+                }
+                out_data[e * H + h] = (scalar_t)val;
+              }
+            }
+          });
+        });
+      });
+
+  return out;
+}
+
+// Computes `out[e] = <x[row[e]], y[col[e]]>` for every non-zero entry `e`,
+// where `x` and `y` are either of shape `[*, K]` or of multi-head shape
+// `[*, H, K]` (resulting in an output of shape `[nnz, H]`).
+torch::Tensor sddmm_cpu(torch::Tensor rowptr, torch::Tensor col,
+                        torch::Tensor x, torch::Tensor y) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(x);
+  CHECK_CPU(y);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(x.dim() == 2 || x.dim() == 3);
+  CHECK_INPUT(x.dim() == y.dim());
+  CHECK_INPUT(x.size(0) == rowptr.numel() - 1);
+  CHECK_INPUT(x.size(-1) == y.size(-1));
+  if (x.dim() == 3)
+    CHECK_INPUT(x.size(1) == y.size(1));
+
+  x = x.contiguous();
+  y = y.contiguous();
+
+  auto M = rowptr.numel() - 1;
+  auto H = x.dim() == 3 ? x.size(1) : 1;
+  auto K = x.size(-1);
+
+  auto out = x.dim() == 3 ? torch::empty({col.numel(), H}, x.options())
+                          : torch::empty({col.numel()}, x.options());
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, x.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto x_data = x.data_ptr<scalar_t>();
+        auto y_data = y.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+
+        int64_t avg_degree = std::max(col.numel() / std::max(M, (int64_t)1),
+                                      (int64_t)1);
+        int64_t grain_size = at::internal::GRAIN_SIZE / (H * K * avg_degree);
+        at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+          acc_t val;
+          for (auto m = begin; m < end; m++) {
+            auto x_offset = m * H * K;
+            for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+              auto y_offset = col_data[e] * H * K;
+              for (auto h = 0; h < H; h++) {
+                val = (acc_t)0;
+                for (auto k = 0; k < K; k++)
+                  val += (acc_t)x_data[x_offset + h * K + k] *
+                         (acc_t)y_data[y_offset + h * K + k];
+                out_data[e * H + h] = (scalar_t)val;
+              }
+            }
           }
-          out_data[e] += val;
-        }
-      }
-    });
-  });
+        });
+      });
 
   return out;
 }
+
+// Fused GAT-style attention aggregation. For every row `i` and head `h`, it
+// computes `out[i, h] = sum_j softmax_j(e_ij) * mat[j, h]` with attention
+// logits `e_ij = LeakyReLU(alpha_dst[i, h] + alpha_src[j, h])`.
+// Logits, softmax and aggregation are computed in a single pass over the
+// neighborhood of `i` via an online softmax, see:
+// https://arxiv.org/abs/1805.02867
+// The normalized attention coefficients of shape `[nnz, H]` are only
+// materialized in case `return_attention` is set.
+std::tuple<torch::Tensor, torch::optional<torch::Tensor>>
+spmm_gat_cpu(torch::Tensor rowptr, torch::Tensor col, torch::Tensor alpha_dst,
+             torch::Tensor alpha_src, torch::Tensor mat, double negative_slope,
+             bool return_attention) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(alpha_dst);
+  CHECK_CPU(alpha_src);
+  CHECK_CPU(mat);
+
+  CHECK_INPUT(rowptr.dim() == 1);
+  CHECK_INPUT(col.dim() == 1);
+  CHECK_INPUT(mat.dim() == 3);
+  CHECK_INPUT(alpha_dst.dim() == 2);
+  CHECK_INPUT(alpha_src.dim() == 2);
+  CHECK_INPUT(alpha_dst.size(0) == rowptr.numel() - 1);
+  CHECK_INPUT(alpha_src.size(0) == mat.size(0));
+  CHECK_INPUT(alpha_dst.size(1) == mat.size(1));
+  CHECK_INPUT(alpha_src.size(1) == mat.size(1));
+
+  alpha_dst = alpha_dst.contiguous();
+  alpha_src = alpha_src.contiguous();
+  mat = mat.contiguous();
+
+  auto M = rowptr.numel() - 1;
+  auto H = mat.size(1);
+  auto K = mat.size(2);
+
+  auto out = torch::empty({M, H, K}, mat.options());
+
+  torch::optional<torch::Tensor> attention = torch::nullopt;
+  if (return_attention)
+    attention = torch::empty({col.numel(), H}, mat.options());
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, mat.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto alpha_dst_data = alpha_dst.data_ptr<scalar_t>();
+        auto alpha_src_data = alpha_src.data_ptr<scalar_t>();
+        auto mat_data = mat.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+        scalar_t *attention_data = nullptr;
+        if (return_attention)
+          attention_data = attention.value().data_ptr<scalar_t>();
+
+        const auto slope = (acc_t)negative_slope;
+        auto leaky_relu = [&](acc_t x) { return x > (acc_t)0 ? x : x * slope; };
+
+        int64_t avg_degree = std::max(col.numel() / std::max(M, (int64_t)1),
+                                      (int64_t)1);
+        int64_t grain_size = at::internal::GRAIN_SIZE / (H * K * avg_degree);
+        at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+          std::vector<acc_t> vals(K);
+          acc_t logit, max, sum, scale, weight;
+          int64_t row_start, row_end, c;
+
+          for (auto m = begin; m < end; m++) {
+            row_start = rowptr_data[m], row_end = rowptr_data[m + 1];
+
+            for (auto h = 0; h < H; h++) {
+              const auto alpha = (acc_t)alpha_dst_data[m * H + h];
+              max = -std::numeric_limits<acc_t>::infinity();
+              sum = (acc_t)0;
+              for (auto k = 0; k < K; k++)
+                vals[k] = (acc_t)0;
+
+              for (auto e = row_start; e < row_end; e++) {
+                c = col_data[e];
+                logit = leaky_relu(alpha + (acc_t)alpha_src_data[c * H + h]);
+                if (logit > max) { // Rescale the accumulator:
+                  scale = std::exp(max - logit);
+                  sum = sum * scale + (acc_t)1;
+                  for (auto k = 0; k < K; k++)
+                    vals[k] = vals[k] * scale +
+                              (acc_t)mat_data[(c * H + h) * K + k];
+                  max = logit;
+                } else {
+                  weight = std::exp(logit - max);
+                  sum += weight;
+                  for (auto k = 0; k < K; k++)
+                    vals[k] += weight * (acc_t)mat_data[(c * H + h) * K + k];
+                }
+              }
+
+              for (auto k = 0; k < K; k++)
+                out_data[(m * H + h) * K + k] =
+                    (scalar_t)(row_end > row_start ? vals[k] / sum : (acc_t)0);
+
+              if (return_attention) {
+                for (auto e = row_start; e < row_end; e++) {
+                  c = col_data[e];
+                  logit =
+                      leaky_relu(alpha + (acc_t)alpha_src_data[c * H + h]);
+                  attention_data[e * H + h] =
+                      (scalar_t)(std::exp(logit - max) / sum);
+                }
+              }
+            }
+          }
+        });
+      });
+
+  return std::make_tuple(out, attention);
+}
+
+// Returns the gradients w.r.t. `alpha_dst` and the per-edge attention scores
+// `alpha_dst[i] + alpha_src[j]` (which need to be scattered to `alpha_src`).
+std::tuple<torch::Tensor, torch::Tensor>
+spmm_gat_bw_cpu(torch::Tensor rowptr, torch::Tensor col,
+                torch::Tensor alpha_dst, torch::Tensor alpha_src,
+                torch::Tensor mat, torch::Tensor out, torch::Tensor attention,
+                torch::Tensor grad_out, double negative_slope) {
+  CHECK_CPU(rowptr);
+  CHECK_CPU(col);
+  CHECK_CPU(alpha_dst);
+  CHECK_CPU(alpha_src);
+  CHECK_CPU(mat);
+  CHECK_CPU(out);
+  CHECK_CPU(attention);
+  CHECK_CPU(grad_out);
+
+  alpha_dst = alpha_dst.contiguous();
+  alpha_src = alpha_src.contiguous();
+  mat = mat.contiguous();
+  out = out.contiguous();
+  attention = attention.contiguous();
+  grad_out = grad_out.contiguous();
+
+  auto M = rowptr.numel() - 1;
+  auto H = mat.size(1);
+  auto K = mat.size(2);
+
+  auto grad_alpha_dst = torch::empty_like(alpha_dst);
+  auto grad_score = torch::empty_like(attention);
+
+  auto rowptr_data = rowptr.data_ptr<int64_t>();
+  auto col_data = col.data_ptr<int64_t>();
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, mat.scalar_type(), "_",
+      [&] {
+        typedef typename AccType<scalar_t>::type acc_t;
+        auto alpha_dst_data = alpha_dst.data_ptr<scalar_t>();
+        auto alpha_src_data = alpha_src.data_ptr<scalar_t>();
+        auto mat_data = mat.data_ptr<scalar_t>();
+        auto out_data = out.data_ptr<scalar_t>();
+        auto attention_data = attention.data_ptr<scalar_t>();
+        auto grad_out_data = grad_out.data_ptr<scalar_t>();
+        auto grad_alpha_dst_data = grad_alpha_dst.data_ptr<scalar_t>();
+        auto grad_score_data = grad_score.data_ptr<scalar_t>();
+
+        const auto slope = (acc_t)negative_slope;
+
+        int64_t avg_degree = std::max(col.numel() / std::max(M, (int64_t)1),
+                                      (int64_t)1);
+        int64_t grain_size = at::internal::GRAIN_SIZE / (H * K * avg_degree);
+        at::parallel_for(0, M, grain_size, [&](int64_t begin, int64_t end) {
+          acc_t dot, grad_attention, grad_logit, score, sum;
+          int64_t c;
+
+          for (auto m = begin; m < end; m++) {
+            for (auto h = 0; h < H; h++) {
+              const auto *grad_row = grad_out_data + (m * H + h) * K;
+              const auto *out_row = out_data + (m * H + h) * K;
+
+              // `<grad_out[i], out[i]>` equals the attention-weighted sum of
+              // the per-edge gradients, as needed by the softmax backward:
+              dot = (acc_t)0;
+              for (auto k = 0; k < K; k++)
+                dot += (acc_t)grad_row[k] * (acc_t)out_row[k];
+
+              sum = (acc_t)0;
+              for (auto e = rowptr_data[m]; e < rowptr_data[m + 1]; e++) {
+                c = col_data[e];
+                const auto *mat_row = mat_data + (c * H + h) * K;
+                grad_attention = (acc_t)0;
+                for (auto k = 0; k < K; k++)
+                  grad_attention += (acc_t)grad_row[k] * (acc_t)mat_row[k];
+
+                grad_logit = (acc_t)attention_data[e * H + h] *
+                             (grad_attention - dot);
+                score = (acc_t)alpha_dst_data[m * H + h] +
+                        (acc_t)alpha_src_data[c * H + h];
+                if (score <= (acc_t)0)
+                  grad_logit *= slope;
+
+                grad_score_data[e * H + h] = (scalar_t)grad_logit;
+                sum += grad_logit;
+              }
+              grad_alpha_dst_data[m * H + h] = (scalar_t)sum;
+            }
+          }
+        });
+      });
+
+  return std::make_tuple(grad_alpha_dst, grad_score);
+}
@@ -9,4 +9,19 @@ spmm_cpu(torch::Tensor rowptr, torch::Tensor col,
 
 torch::Tensor spmm_value_bw_cpu(torch::Tensor row, torch::Tensor rowptr,
                                 torch::Tensor col, torch::Tensor mat,
-                                torch::Tensor grad, std::string reduce);
+                                torch::Tensor grad, std::string reduce,
+                                bool multi_head);
+
+torch::Tensor sddmm_cpu(torch::Tensor rowptr, torch::Tensor col,
+                        torch::Tensor x, torch::Tensor y);
+
+std::tuple<torch::Tensor, torch::optional<torch::Tensor>>
+spmm_gat_cpu(torch::Tensor rowptr, torch::Tensor col, torch::Tensor alpha_dst,
+             torch::Tensor alpha_src, torch::Tensor mat, double negative_slope,
+             bool return_attention);
+
+std::tuple<torch::Tensor, torch::Tensor>
+spmm_gat_bw_cpu(torch::Tensor rowptr, torch::Tensor col,
+                torch::Tensor alpha_dst, torch::Tensor alpha_src,
+                torch::Tensor mat, torch::Tensor out, torch::Tensor attention,
+                torch::Tensor grad_out, double negative_slope);
@@ -55,7 +55,9 @@ spspmm_cpu(torch::Tensor rowptrA, torch::Tensor colA,
   torch::Tensor colC;
   torch::optional<torch::Tensor> optional_valueC = torch::nullopt;
 
-  AT_DISPATCH_ALL_TYPES(scalar_type, "spspmm", [&] {
+  AT_DISPATCH_ALL_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16,
+                             scalar_type, "spspmm", [&] {
+    typedef typename AccType<scalar_t>::type acc_t;
     AT_DISPATCH_HAS_VALUE(optional_valueA, [&] {
       scalar_t *valA_data = nullptr, *valB_data = nullptr;
       if (HAS_VALUE) {
@@ -64,7 +66,7 @@ spspmm_cpu(torch::Tensor rowptrA, torch::Tensor colA,
       }
 
       int64_t nnz = 0, cA, cB;
-      std::vector<scalar_t> tmp_vals(K, 0);
+      std::vector<acc_t> tmp_vals(K, 0);
       std::vector<int64_t> cols;
       std::vector<scalar_t> vals;
 
@@ -75,7 +77,7 @@ spspmm_cpu(torch::Tensor rowptrA, torch::Tensor colA,
             cB = colB_data[eB];
 
             if (HAS_VALUE)
-              tmp_vals[cB] += valA_data[eA] * valB_data[eB];
+              tmp_vals[cB] += (acc_t)valA_data[eA] * (acc_t)valB_data[eB];
             else
               tmp_vals[cB]++;
           }
@@ -85,10 +87,10 @@ spspmm_cpu(torch::Tensor rowptrA, torch::Tensor colA,
           if (tmp_vals[k] != 0) {
             cols.push_back(k);
             if (HAS_VALUE)
-              vals.push_back(tmp_vals[k]);
+              vals.push_back((scalar_t)tmp_vals[k]);
             nnz++;
           }
-          tmp_vals[k] = (scalar_t)0;
+          tmp_vals[k] = (acc_t)0;
         }
         rowptrC_data[rA + 1] = nnz;
       }
@@ -16,6 +16,11 @@
     }                                                                          \
   }()
 
+// Half and BFloat16 inputs are accumulated in single precision:
+template <typename scalar_t> struct AccType { typedef scalar_t type; };
+template <> struct AccType<at::Half> { typedef float type; };
+template <> struct AccType<at::BFloat16> { typedef float type; };
+
 template <typename scalar_t>
 inline torch::Tensor from_vector(const std::vector<scalar_t> &vec,
                                  bool inplace = false) {
@@ -0,0 +1,48 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/index_select_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__index_select_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__index_select_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_row(torch::Tensor rowptr, torch::Tensor col, torch::Tensor idx) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return index_select_row_cpu(rowptr, col, idx);
+  }
+}
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_col(torch::Tensor rowptr, torch::Tensor col, torch::Tensor idx,
+                 int64_t N) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return index_select_col_cpu(rowptr, col, idx, N);
+  }
+}
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("torch_sparse::index_select_row", &index_select_row)
+        .op("torch_sparse::index_select_col", &index_select_col);
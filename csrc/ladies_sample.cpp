@@ -0,0 +1,37 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/ladies_sample_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__ladies_sample_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__ladies_sample_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+// Returns 'node', 'node_ptr', 'rowptr', 'col', 'edge', 'weight'
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor, torch::Tensor, torch::Tensor>
+ladies_sample(torch::Tensor colptr, torch::Tensor row,
+              torch::optional<torch::Tensor> optional_value,
+              torch::Tensor input_node, std::vector<int64_t> layer_sizes) {
+  if (colptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return ladies_sample_cpu(colptr, row, optional_value, input_node,
+                             layer_sizes);
+  }
+}
+
+static auto registry = torch::RegisterOperators().op(
+    "torch_sparse::ladies_sample", &ladies_sample);
@@ -63,7 +63,42 @@ SPARSE_API torch::Tensor mt_partition(torch::Tensor rowptr, torch::Tensor col,
   }
 }
 
-static auto registry = torch::RegisterOperators()
-                           .op("torch_sparse::partition", &partition)
-                           .op("torch_sparse::partition2", &partition2)
-                           .op("torch_sparse::mt_partition", &mt_partition);
+SPARSE_API torch::Tensor
+stream_partition(torch::Tensor rowptr, torch::Tensor col,
+                 torch::optional<torch::Tensor> optional_value,
+                 torch::optional<torch::Tensor> optional_node_weight,
+                 int64_t num_parts, bool fennel, int64_t num_workers) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return stream_partition_cpu(rowptr, col, optional_value,
+                                optional_node_weight, num_parts, fennel,
+                                num_workers);
+  }
+}
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+cluster_subgraph(torch::Tensor rowptr, torch::Tensor col, torch::Tensor partptr,
+                 torch::Tensor cluster) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return cluster_subgraph_cpu(rowptr, col, partptr, cluster);
+  }
+}
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("torch_sparse::partition", &partition)
+        .op("torch_sparse::partition2", &partition2)
+        .op("torch_sparse::mt_partition", &mt_partition)
+        .op("torch_sparse::stream_partition", &stream_partition)
+        .op("torch_sparse::cluster_subgraph", &cluster_subgraph);
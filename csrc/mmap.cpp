@@ -0,0 +1,83 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/mmap_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__mmap_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__mmap_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API void
+csr_save(std::string path, torch::Tensor rowptr, torch::Tensor col,
+         torch::optional<torch::Tensor> optional_value,
+         torch::optional<torch::Tensor> optional_colptr,
+         torch::optional<torch::Tensor> optional_csr2csc,
+         torch::optional<torch::Tensor> optional_row,
+         torch::optional<torch::Tensor> optional_rowcount,
+         torch::optional<torch::Tensor> optional_colcount,
+         torch::optional<torch::Tensor> optional_csc2csr, int64_t num_rows,
+         int64_t num_cols) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    csr_save_cpu(path, rowptr, col, optional_value, optional_colptr,
+                 optional_csr2csc, optional_row, optional_rowcount,
+                 optional_colcount, optional_csc2csr, num_rows, num_cols);
+  }
+}
+
+SPARSE_API csr_sections_t csr_load(std::string path) {
+  return csr_load_cpu(path);
+}
+
+SPARSE_API void
+shm_store_create(std::string name, torch::Tensor rowptr, torch::Tensor col,
+                 torch::optional<torch::Tensor> optional_value,
+                 torch::optional<torch::Tensor> optional_colptr,
+                 torch::optional<torch::Tensor> optional_csr2csc,
+                 torch::optional<torch::Tensor> optional_row,
+                 torch::optional<torch::Tensor> optional_rowcount,
+                 torch::optional<torch::Tensor> optional_colcount,
+                 torch::optional<torch::Tensor> optional_csc2csr,
+                 int64_t num_rows, int64_t num_cols) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    shm_store_create_cpu(name, rowptr, col, optional_value, optional_colptr,
+                         optional_csr2csc, optional_row, optional_rowcount,
+                         optional_colcount, optional_csc2csr, num_rows,
+                         num_cols);
+  }
+}
+
+SPARSE_API csr_sections_t shm_store_attach(std::string name) {
+  return shm_store_attach_cpu(name);
+}
+
+SPARSE_API void shm_store_unlink(std::string name) {
+  shm_store_unlink_cpu(name);
+}
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("torch_sparse::csr_save", &csr_save)
+        .op("torch_sparse::csr_load", &csr_load)
+        .op("torch_sparse::shm_store_create", &shm_store_create)
+        .op("torch_sparse::shm_store_attach", &shm_store_attach)
+        .op("torch_sparse::shm_store_unlink", &shm_store_unlink);
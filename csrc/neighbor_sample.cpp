@@ -25,6 +25,37 @@ neighbor_sample(const torch::Tensor &colptr, const torch::Tensor &row,
                              directed);
 }
 
+// Returns 'output_node', 'row', 'col', 'output_edge', 'x', 'edge_attr'
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::optional<torch::Tensor>,
+                      torch::optional<torch::Tensor>>
+neighbor_sample_gather(const torch::Tensor &colptr, const torch::Tensor &row,
+                       const torch::Tensor &input_node,
+                       const std::vector<int64_t> num_neighbors,
+                       const bool replace, const bool directed,
+                       torch::optional<torch::Tensor> optional_x,
+                       torch::optional<torch::Tensor> optional_x_out,
+                       torch::optional<torch::Tensor> optional_edge_attr,
+                       torch::optional<torch::Tensor> optional_edge_out) {
+  return neighbor_sample_gather_cpu(colptr, row, input_node, num_neighbors,
+                                    replace, directed, optional_x,
+                                    optional_x_out, optional_edge_attr,
+                                    optional_edge_out);
+}
+
+// Returns 'output_node', 'row', 'col', 'output_edge'
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+out_of_core_neighbor_sample(const torch::Tensor &colptr,
+                            const torch::Tensor &row,
+                            const torch::Tensor &input_node,
+                            const std::vector<int64_t> num_neighbors,
+                            const bool replace, const bool directed,
+                            const int64_t num_io_threads) {
+  return out_of_core_neighbor_sample_cpu(colptr, row, input_node,
+                                         num_neighbors, replace, directed,
+                                         num_io_threads);
+}
+
 SPARSE_API std::tuple<c10::Dict<node_t, torch::Tensor>, c10::Dict<rel_t, torch::Tensor>,
            c10::Dict<rel_t, torch::Tensor>, c10::Dict<rel_t, torch::Tensor>>
 hetero_neighbor_sample(
@@ -43,4 +74,15 @@ hetero_neighbor_sample(
 static auto registry =
     torch::RegisterOperators()
         .op("torch_sparse::neighbor_sample", &neighbor_sample)
+        .op("torch_sparse::neighbor_sample_gather", &neighbor_sample_gather)
+        .op("torch_sparse::out_of_core_neighbor_sample",
+            &out_of_core_neighbor_sample)
         .op("torch_sparse::hetero_neighbor_sample", &hetero_neighbor_sample);
+
+static auto pipeline_registry =
+    torch::class_<NeighborSamplerPipeline>("torch_sparse",
+                                           "NeighborSamplerPipeline")
+        .def(torch::init<torch::Tensor, torch::Tensor, torch::Tensor, int64_t,
+                         std::vector<int64_t>, bool, bool, int64_t, int64_t>())
+        .def("next", &NeighborSamplerPipeline::next)
+        .def("num_batches", &NeighborSamplerPipeline::num_batches);
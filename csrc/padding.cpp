@@ -0,0 +1,87 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/padding_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__padding_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__padding_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+torch::Tensor padded_index_select_fw(torch::Tensor src, torch::Tensor index,
+                                     torch::Tensor fill_value) {
+  if (src.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return padded_index_select_cpu(src, index, fill_value);
+  }
+}
+
+using torch::autograd::AutogradContext;
+using torch::autograd::Variable;
+using torch::autograd::variable_list;
+
+class PaddedIndexSelect
+    : public torch::autograd::Function<PaddedIndexSelect> {
+public:
+  static variable_list forward(AutogradContext *ctx, Variable src,
+                               Variable index, Variable fill_value) {
+    ctx->saved_data["src_size"] = src.size(0);
+    ctx->save_for_backward({index});
+    return {padded_index_select_fw(src, index, fill_value)};
+  }
+
+  static variable_list backward(AutogradContext *ctx, variable_list grad_outs) {
+    auto grad_out = grad_outs[0];
+    auto src_size = ctx->saved_data["src_size"].toInt();
+    auto index = ctx->get_saved_variables()[0];
+
+    // Padding entries do not contribute to the gradient:
+    auto perm = index.ne(-1).nonzero().view(-1);
+    auto sizes = grad_out.sizes().vec();
+    sizes[0] = src_size;
+    auto grad_src = torch::zeros(sizes, grad_out.options());
+    grad_src.index_add_(0, index.index_select(0, perm),
+                        grad_out.index_select(0, perm));
+
+    return {grad_src, Variable(), Variable()};
+  }
+};
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor, std::vector<int64_t>,
+                      std::vector<int64_t>>
+padded_index(torch::Tensor rowptr, torch::Tensor col, torch::Tensor rowcount,
+             torch::Tensor binptr) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return padded_index_cpu(rowptr, col, rowcount, binptr);
+  }
+}
+
+SPARSE_API torch::Tensor padded_index_select(torch::Tensor src,
+                                             torch::Tensor index,
+                                             torch::Tensor fill_value) {
+  return PaddedIndexSelect::apply(src, index, fill_value)[0];
+}
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("torch_sparse::padded_index", &padded_index)
+        .op("torch_sparse::padded_index_select", &padded_index_select);
@@ -0,0 +1,32 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/permute_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__permute_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__permute_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+permute(torch::Tensor rowptr, torch::Tensor col, torch::Tensor perm) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return permute_cpu(rowptr, col, perm);
+  }
+}
+
+static auto registry =
+    torch::RegisterOperators().op("torch_sparse::permute", &permute);
@@ -0,0 +1,49 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/sell_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__sell_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__sell_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor>
+to_sell(torch::Tensor rowptr, torch::Tensor col, int64_t chunk_size,
+        int64_t sigma) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return to_sell_cpu(rowptr, col, chunk_size, sigma);
+  }
+}
+
+SPARSE_API torch::Tensor
+sell_spmm(torch::Tensor perm, torch::Tensor chunkptr, torch::Tensor col,
+          torch::Tensor value, torch::Tensor mat, int64_t chunk_size) {
+  if (mat.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return sell_spmm_cpu(perm, chunkptr, col, value, mat, chunk_size);
+  }
+}
+
+static auto registry = torch::RegisterOperators()
+                           .op("torch_sparse::to_sell", &to_sell)
+                           .op("torch_sparse::sell_spmm", &sell_spmm);
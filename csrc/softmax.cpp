@@ -0,0 +1,75 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/softmax_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__softmax_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__softmax_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+torch::Tensor softmax_fw(torch::Tensor rowptr, torch::Tensor value,
+                         bool inplace) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return softmax_fw_cpu(rowptr, value, inplace);
+  }
+}
+
+torch::Tensor softmax_bw(torch::Tensor rowptr, torch::Tensor out,
+                         torch::Tensor grad_out) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return softmax_bw_cpu(rowptr, out, grad_out);
+  }
+}
+
+using torch::autograd::AutogradContext;
+using torch::autograd::Variable;
+using torch::autograd::variable_list;
+
+class SparseSoftmax : public torch::autograd::Function<SparseSoftmax> {
+public:
+  static variable_list forward(AutogradContext *ctx, Variable rowptr,
+                               Variable value, bool inplace) {
+    auto out = softmax_fw(rowptr, value, inplace);
+    if (inplace)
+      ctx->mark_dirty({value});
+    ctx->save_for_backward({rowptr, out});
+    return {out};
+  }
+
+  static variable_list backward(AutogradContext *ctx, variable_list grad_outs) {
+    auto grad_out = grad_outs[0];
+    auto saved = ctx->get_saved_variables();
+    auto rowptr = saved[0], out = saved[1];
+
+    auto grad_value = softmax_bw(rowptr, out, grad_out);
+    return {Variable(), grad_value, Variable()};
+  }
+};
+
+SPARSE_API torch::Tensor sparse_softmax(torch::Tensor rowptr,
+                                        torch::Tensor value, bool inplace) {
+  return SparseSoftmax::apply(rowptr, value, inplace)[0];
+}
+
+static auto registry = torch::RegisterOperators().op(
+    "torch_sparse::sparse_softmax", &sparse_softmax);
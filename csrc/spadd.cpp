@@ -0,0 +1,66 @@
+#ifdef WITH_PYTHON
+#include <Python.h>
+#endif
+#include <torch/script.h>
+
+#include "cpu/spadd_cpu.h"
+
+#ifdef _WIN32
+#ifdef WITH_PYTHON
+#ifdef WITH_CUDA
+PyMODINIT_FUNC PyInit__spadd_cuda(void) { return NULL; }
+#else
+PyMODINIT_FUNC PyInit__spadd_cpu(void) { return NULL; }
+#endif
+#endif
+#endif
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+spadd(torch::Tensor rowptrA, torch::Tensor colA, torch::Tensor rowptrB,
+      torch::Tensor colB) {
+  if (rowptrA.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return spadd_cpu(rowptrA, colA, rowptrB, colB);
+  }
+}
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor, torch::Tensor>
+to_symmetric(torch::Tensor rowptr, torch::Tensor col, int64_t N,
+             torch::optional<torch::Tensor> optional_colptr,
+             torch::optional<torch::Tensor> optional_csr2csc) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return to_symmetric_cpu(rowptr, col, N, optional_colptr,
+                            optional_csr2csc);
+  }
+}
+
+SPARSE_API bool is_symmetric(torch::Tensor rowptr, torch::Tensor col,
+                             torch::optional<torch::Tensor> optional_value) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return is_symmetric_cpu(rowptr, col, optional_value);
+  }
+}
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("torch_sparse::spadd", &spadd)
+        .op("torch_sparse::to_symmetric", &to_symmetric)
+        .op("torch_sparse::is_symmetric", &is_symmetric);
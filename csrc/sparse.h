@@ -33,6 +33,16 @@ SPARSE_API torch::Tensor mt_partition(torch::Tensor rowptr, torch::Tensor col,
                            int64_t num_parts, bool recursive,
                            int64_t num_workers);
  
+SPARSE_API torch::Tensor
+stream_partition(torch::Tensor rowptr, torch::Tensor col,
+                 torch::optional<torch::Tensor> optional_value,
+                 torch::optional<torch::Tensor> optional_node_weight,
+                 int64_t num_parts, bool fennel, int64_t num_workers);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+cluster_subgraph(torch::Tensor rowptr, torch::Tensor col, torch::Tensor partptr,
+                 torch::Tensor cluster);
+
 SPARSE_API std::tuple<torch::Tensor, torch::Tensor> relabel(torch::Tensor col,
                                                  torch::Tensor idx);
 
@@ -53,6 +63,12 @@ SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor
 sample_adj(torch::Tensor rowptr, torch::Tensor col, torch::Tensor idx,
            int64_t num_neighbors, bool replace);
 
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor, torch::Tensor, torch::Tensor>
+ladies_sample(torch::Tensor colptr, torch::Tensor row,
+              torch::optional<torch::Tensor> optional_value,
+              torch::Tensor input_node, std::vector<int64_t> layer_sizes);
+
 SPARSE_API torch::Tensor spmm_sum(torch::optional<torch::Tensor> opt_row,
                        torch::Tensor rowptr, torch::Tensor col,
                        torch::optional<torch::Tensor> opt_value,
@@ -76,8 +92,143 @@ SPARSE_API std::tuple<torch::Tensor, torch::Tensor>
 spmm_max(torch::Tensor rowptr, torch::Tensor col,
          torch::optional<torch::Tensor> opt_value, torch::Tensor mat);
 
+SPARSE_API torch::Tensor sddmm(torch::optional<torch::Tensor> opt_row,
+                                torch::Tensor rowptr, torch::Tensor col,
+                                torch::optional<torch::Tensor> opt_colptr,
+                                torch::optional<torch::Tensor> opt_csr2csc,
+                                torch::Tensor x, torch::Tensor y);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor>
+spmm_gat(torch::optional<torch::Tensor> opt_row, torch::Tensor rowptr,
+         torch::Tensor col, torch::optional<torch::Tensor> opt_colptr,
+         torch::optional<torch::Tensor> opt_csr2csc, torch::Tensor alpha_dst,
+         torch::Tensor alpha_src, torch::Tensor mat, double negative_slope,
+         bool return_attention);
+
 SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::optional<torch::Tensor>>
 spspmm_sum(torch::Tensor rowptrA, torch::Tensor colA,
            torch::optional<torch::Tensor> optional_valueA,
            torch::Tensor rowptrB, torch::Tensor colB,
-           torch::optional<torch::Tensor> optional_valueB, int64_t K); 
+           torch::optional<torch::Tensor> optional_valueB, int64_t K);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor>
+spadd(torch::Tensor rowptrA, torch::Tensor colA, torch::Tensor rowptrB,
+      torch::Tensor colB);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor, torch::Tensor>
+to_symmetric(torch::Tensor rowptr, torch::Tensor col, int64_t N,
+             torch::optional<torch::Tensor> optional_colptr,
+             torch::optional<torch::Tensor> optional_csr2csc);
+
+SPARSE_API bool is_symmetric(torch::Tensor rowptr, torch::Tensor col,
+                             torch::optional<torch::Tensor> optional_value);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+coalesce(torch::Tensor rowptr, torch::Tensor col);
+
+SPARSE_API bool is_sorted(torch::Tensor row, torch::Tensor col, bool strict);
+
+SPARSE_API torch::Tensor sort_coo(torch::Tensor row, torch::Tensor col,
+                                  int64_t M);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_row(torch::Tensor rowptr, torch::Tensor col, torch::Tensor idx);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+index_select_col(torch::Tensor rowptr, torch::Tensor col, torch::Tensor idx,
+                 int64_t N);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+permute(torch::Tensor rowptr, torch::Tensor col, torch::Tensor perm);
+
+SPARSE_API torch::Tensor cat_offset(std::vector<torch::Tensor> tensors,
+                                    std::vector<int64_t> offsets,
+                                    bool skip_first);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor, std::vector<int64_t>,
+                      std::vector<int64_t>>
+padded_index(torch::Tensor rowptr, torch::Tensor col, torch::Tensor rowcount,
+             torch::Tensor binptr);
+
+SPARSE_API torch::Tensor padded_index_select(torch::Tensor src,
+                                             torch::Tensor index,
+                                             torch::Tensor fill_value);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor>
+to_sell(torch::Tensor rowptr, torch::Tensor col, int64_t chunk_size,
+        int64_t sigma);
+
+SPARSE_API torch::Tensor
+sell_spmm(torch::Tensor perm, torch::Tensor chunkptr, torch::Tensor col,
+          torch::Tensor value, torch::Tensor mat, int64_t chunk_size);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>
+csr2bsr(torch::Tensor rowptr, torch::Tensor col, int64_t R, int64_t C);
+
+SPARSE_API torch::Tensor bsr_spmm(torch::Tensor browptr, torch::Tensor bcol,
+                                  torch::Tensor bvalue, torch::Tensor mat,
+                                  int64_t M);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor>
+compress_csr(torch::Tensor rowptr, torch::Tensor col);
+
+SPARSE_API torch::Tensor decompress_csr(torch::Tensor rowptr,
+                                        torch::Tensor byteptr,
+                                        torch::Tensor data);
+
+SPARSE_API torch::Tensor
+compressed_spmm(torch::Tensor rowptr, torch::Tensor byteptr, torch::Tensor data,
+                torch::optional<torch::Tensor> optional_value,
+                torch::Tensor mat);
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+                      torch::Tensor>
+compressed_sample_adj(torch::Tensor rowptr, torch::Tensor byteptr,
+                      torch::Tensor data, torch::Tensor idx,
+                      int64_t num_neighbors, bool replace);
+
+SPARSE_API void
+csr_save(std::string path, torch::Tensor rowptr, torch::Tensor col,
+         torch::optional<torch::Tensor> optional_value,
+         torch::optional<torch::Tensor> optional_colptr,
+         torch::optional<torch::Tensor> optional_csr2csc,
+         torch::optional<torch::Tensor> optional_row,
+         torch::optional<torch::Tensor> optional_rowcount,
+         torch::optional<torch::Tensor> optional_colcount,
+         torch::optional<torch::Tensor> optional_csc2csr, int64_t num_rows,
+         int64_t num_cols);
+
+SPARSE_API std::tuple<
+    torch::Tensor, torch::Tensor, torch::optional<torch::Tensor>,
+    torch::optional<torch::Tensor>, torch::optional<torch::Tensor>,
+    torch::optional<torch::Tensor>, torch::optional<torch::Tensor>,
+    torch::optional<torch::Tensor>, torch::optional<torch::Tensor>, int64_t,
+    int64_t>
+csr_load(std::string path);
+
+SPARSE_API void
+shm_store_create(std::string name, torch::Tensor rowptr, torch::Tensor col,
+                 torch::optional<torch::Tensor> optional_value,
+                 torch::optional<torch::Tensor> optional_colptr,
+                 torch::optional<torch::Tensor> optional_csr2csc,
+                 torch::optional<torch::Tensor> optional_row,
+                 torch::optional<torch::Tensor> optional_rowcount,
+                 torch::optional<torch::Tensor> optional_colcount,
+                 torch::optional<torch::Tensor> optional_csc2csr,
+                 int64_t num_rows, int64_t num_cols);
+
+SPARSE_API std::tuple<
+    torch::Tensor, torch::Tensor, torch::optional<torch::Tensor>,
+    torch::optional<torch::Tensor>, torch::optional<torch::Tensor>,
+    torch::optional<torch::Tensor>, torch::optional<torch::Tensor>,
+    torch::optional<torch::Tensor>, torch::optional<torch::Tensor>, int64_t,
+    int64_t>
+shm_store_attach(std::string name);
+
+SPARSE_API void shm_store_unlink(std::string name);
+
+SPARSE_API torch::Tensor sparse_softmax(torch::Tensor rowptr,
+                                        torch::Tensor value, bool inplace);
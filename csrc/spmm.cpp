@@ -25,6 +25,22 @@ spmm_fw(torch::Tensor rowptr, torch::Tensor col,
         std::string reduce) {
   if (rowptr.device().is_cuda()) {
 #ifdef WITH_CUDA
+    if (optional_value.has_value() && optional_value.value().dim() == 2) {
+      // Multi-head edge weights are processed head by head on the GPU:
+      auto value = optional_value.value();
+      std::vector<torch::Tensor> outs, arg_outs;
+      for (int64_t h = 0; h < value.size(1); h++) {
+        auto result = spmm_cuda(rowptr, col, value.select(1, h).contiguous(),
+                                mat.select(-2, h), reduce);
+        outs.push_back(std::get<0>(result));
+        if (std::get<1>(result).has_value())
+          arg_outs.push_back(std::get<1>(result).value());
+      }
+      torch::optional<torch::Tensor> arg_out = torch::nullopt;
+      if (arg_outs.size() > 0)
+        arg_out = torch::stack(arg_outs, -2);
+      return std::make_tuple(torch::stack(outs, -2), arg_out);
+    }
     return spmm_cuda(rowptr, col, optional_value, mat, reduce);
 #else
     AT_ERROR("Not compiled with CUDA support");
@@ -36,15 +52,69 @@ spmm_fw(torch::Tensor rowptr, torch::Tensor col,
 
 torch::Tensor spmm_value_bw(torch::Tensor row, torch::Tensor rowptr,
                             torch::Tensor col, torch::Tensor mat,
-                            torch::Tensor grad, std::string reduce) {
+                            torch::Tensor grad, std::string reduce,
+                            bool multi_head) {
   if (row.device().is_cuda()) {
 #ifdef WITH_CUDA
+    if (multi_head) {
+      std::vector<torch::Tensor> outs;
+      for (int64_t h = 0; h < mat.size(-2); h++)
+        outs.push_back(spmm_value_bw_cuda(row, rowptr, col, mat.select(-2, h),
+                                          grad.select(-2, h), reduce));
+      return torch::stack(outs, 1);
+    }
     return spmm_value_bw_cuda(row, rowptr, col, mat, grad, reduce);
 #else
     AT_ERROR("Not compiled with CUDA support");
 #endif
   } else {
-    return spmm_value_bw_cpu(row, rowptr, col, mat, grad, reduce);
+    return spmm_value_bw_cpu(row, rowptr, col, mat, grad, reduce, multi_head);
+  }
+}
+
+torch::Tensor sddmm_fw(torch::Tensor rowptr, torch::Tensor col,
+                       torch::Tensor x, torch::Tensor y) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return sddmm_cpu(rowptr, col, x, y);
+  }
+}
+
+std::tuple<torch::Tensor, torch::optional<torch::Tensor>>
+spmm_gat_fw(torch::Tensor rowptr, torch::Tensor col, torch::Tensor alpha_dst,
+            torch::Tensor alpha_src, torch::Tensor mat, double negative_slope,
+            bool return_attention) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return spmm_gat_cpu(rowptr, col, alpha_dst, alpha_src, mat, negative_slope,
+                        return_attention);
+  }
+}
+
+std::tuple<torch::Tensor, torch::Tensor>
+spmm_gat_bw(torch::Tensor rowptr, torch::Tensor col, torch::Tensor alpha_dst,
+            torch::Tensor alpha_src, torch::Tensor mat, torch::Tensor out,
+            torch::Tensor attention, torch::Tensor grad_out,
+            double negative_slope) {
+  if (rowptr.device().is_cuda()) {
+#ifdef WITH_CUDA
+    AT_ERROR("No CUDA version supported");
+#else
+    AT_ERROR("Not compiled with CUDA support");
+#endif
+  } else {
+    return spmm_gat_bw_cpu(rowptr, col, alpha_dst, alpha_src, mat, out,
+                           attention, grad_out, negative_slope);
   }
 }
 
@@ -94,14 +164,15 @@ public:
 
     auto grad_value = Variable();
     if (has_value > 0 && torch::autograd::any_variable_requires_grad({value})) {
-      grad_value = spmm_value_bw(row, rowptr, col, mat, grad_out, "sum");
+      grad_value = spmm_value_bw(row, rowptr, col, mat, grad_out, "sum",
+                                 value.dim() == 2);
     }
 
     auto grad_mat = Variable();
     if (torch::autograd::any_variable_requires_grad({mat})) {
       torch::optional<torch::Tensor> opt_value = torch::nullopt;
       if (has_value)
-        opt_value = value.view({-1, 1}).index_select(0, csr2csc).view(-1);
+        opt_value = value.index_select(0, csr2csc);
 
       grad_mat = std::get<0>(spmm_fw(colptr, row.index_select(0, csr2csc),
                                      opt_value, grad_out, "sum"));
@@ -159,7 +230,8 @@ public:
 
     auto grad_value = Variable();
     if (has_value > 0 && torch::autograd::any_variable_requires_grad({value})) {
-      grad_value = spmm_value_bw(row, rowptr, col, mat, grad_out, "mean");
+      grad_value = spmm_value_bw(row, rowptr, col, mat, grad_out, "mean",
+                                 value.dim() == 2);
     }
 
     auto grad_mat = Variable();
@@ -168,7 +240,9 @@ public:
       rowcount = rowcount.index_select(0, row).toType(mat.scalar_type());
       rowcount.masked_fill_(rowcount < 1, 1);
 
-      if (has_value > 0)
+      if (has_value > 0 && value.dim() == 2)
+        rowcount = value.index_select(0, csr2csc).div(rowcount.view({-1, 1}));
+      else if (has_value > 0)
         rowcount =
             value.view({-1, 1}).index_select(0, csr2csc).view(-1).div(rowcount);
       else
@@ -210,22 +284,32 @@ public:
     auto invalid_arg_mask = arg_out == col.size(0);
     arg_out = arg_out.masked_fill(invalid_arg_mask, 0);
 
+    // Multi-head features are laid out as `[*, N, H, K]`, and `value_arg`
+    // refers to the flattened `[nnz, H]` edge weights:
+    auto multi_head = has_value > 0 && value.dim() == 2;
+    auto dim = multi_head ? -3 : -2;
+    auto value_arg = arg_out;
+    if (multi_head)
+      value_arg = arg_out * value.size(1) +
+                  torch::arange(value.size(1), arg_out.options()).view({-1, 1});
+
     auto grad_value = Variable();
     if (has_value > 0 && torch::autograd::any_variable_requires_grad({value})) {
       auto ind = col.index_select(0, arg_out.flatten()).view_as(arg_out);
-      auto out = mat.gather(-2, ind);
+      auto out = mat.gather(dim, ind);
       out.mul_(grad_out);
       out.masked_fill_(invalid_arg_mask, 0);
 
-      grad_value = torch::zeros_like(value);
-      grad_value.scatter_add_(0, arg_out.flatten(), out.flatten());
+      grad_value = torch::zeros(value.numel(), value.options());
+      grad_value.scatter_add_(0, value_arg.flatten(), out.flatten());
+      grad_value = grad_value.view_as(value);
     }
 
     auto grad_mat = Variable();
     if (torch::autograd::any_variable_requires_grad({mat})) {
       if (has_value > 0) {
-        value = value.view({-1, 1})
-                    .index_select(0, arg_out.flatten())
+        value = value.reshape(-1)
+                    .index_select(0, value_arg.flatten())
                     .view_as(arg_out)
                     .mul_(grad_out);
       } else
@@ -235,7 +319,7 @@ public:
       auto ind = col.index_select(0, arg_out.flatten()).view_as(arg_out);
 
       grad_mat = torch::zeros_like(mat);
-      grad_mat.scatter_add_(-2, ind, value);
+      grad_mat.scatter_add_(dim, ind, value);
     }
 
     return {Variable(), Variable(), grad_value, grad_mat, Variable()};
@@ -270,22 +354,32 @@ public:
     auto invalid_arg_mask = arg_out == col.size(0);
     arg_out = arg_out.masked_fill(invalid_arg_mask, 0);
 
+    // Multi-head features are laid out as `[*, N, H, K]`, and `value_arg`
+    // refers to the flattened `[nnz, H]` edge weights:
+    auto multi_head = has_value > 0 && value.dim() == 2;
+    auto dim = multi_head ? -3 : -2;
+    auto value_arg = arg_out;
+    if (multi_head)
+      value_arg = arg_out * value.size(1) +
+                  torch::arange(value.size(1), arg_out.options()).view({-1, 1});
+
     auto grad_value = Variable();
     if (has_value > 0 && torch::autograd::any_variable_requires_grad({value})) {
       auto ind = col.index_select(0, arg_out.flatten()).view_as(arg_out);
-      auto out = mat.gather(-2, ind);
+      auto out = mat.gather(dim, ind);
       out.mul_(grad_out);
       out.masked_fill_(invalid_arg_mask, 0);
 
-      grad_value = torch::zeros_like(value);
-      grad_value.scatter_add_(0, arg_out.flatten(), out.flatten());
+      grad_value = torch::zeros(value.numel(), value.options());
+      grad_value.scatter_add_(0, value_arg.flatten(), out.flatten());
+      grad_value = grad_value.view_as(value);
     }
 
     auto grad_mat = Variable();
     if (torch::autograd::any_variable_requires_grad({mat})) {
       if (has_value > 0) {
-        value = value.view({-1, 1})
-                    .index_select(0, arg_out.flatten())
+        value = value.reshape(-1)
+                    .index_select(0, value_arg.flatten())
                     .view_as(arg_out)
                     .mul_(grad_out);
       } else
@@ -295,13 +389,129 @@ public:
       auto ind = col.index_select(0, arg_out.flatten()).view_as(arg_out);
 
       grad_mat = torch::zeros_like(mat);
-      grad_mat.scatter_add_(-2, ind, value);
+      grad_mat.scatter_add_(dim, ind, value);
     }
 
     return {Variable(), Variable(), grad_value, grad_mat, Variable()};
   }
 };
 
+class SDDMM : public torch::autograd::Function<SDDMM> {
+public:
+  static variable_list forward(AutogradContext *ctx,
+                               torch::optional<Variable> opt_row,
+                               Variable rowptr, Variable col,
+                               torch::optional<Variable> opt_colptr,
+                               torch::optional<Variable> opt_csr2csc,
+                               Variable x, Variable y) {
+
+    if (torch::autograd::any_variable_requires_grad({y})) {
+      AT_ASSERTM(opt_row.has_value(), "Argument `row` is missing");
+      AT_ASSERTM(opt_colptr.has_value(), "Argument `colptr` is missing");
+      AT_ASSERTM(opt_csr2csc.has_value(), "Argument `csr2csc` is missing");
+    }
+
+    auto row = opt_row.has_value() ? opt_row.value() : col;
+    auto colptr = opt_colptr.has_value() ? opt_colptr.value() : col;
+    auto csr2csc = opt_csr2csc.has_value() ? opt_csr2csc.value() : col;
+
+    auto out = sddmm_fw(rowptr, col, x, y);
+    ctx->save_for_backward({row, rowptr, col, colptr, csr2csc, x, y});
+    return {out};
+  }
+
+  static variable_list backward(AutogradContext *ctx, variable_list grad_outs) {
+    auto grad_out = grad_outs[0].contiguous();
+    auto saved = ctx->get_saved_variables();
+    auto row = saved[0], rowptr = saved[1], col = saved[2], colptr = saved[3],
+         csr2csc = saved[4], x = saved[5], y = saved[6];
+
+    auto grad_x = Variable();
+    if (torch::autograd::any_variable_requires_grad({x})) {
+      grad_x = std::get<0>(spmm_fw(rowptr, col, grad_out, y, "sum"));
+    }
+
+    auto grad_y = Variable();
+    if (torch::autograd::any_variable_requires_grad({y})) {
+      grad_y = std::get<0>(spmm_fw(colptr, row.index_select(0, csr2csc),
+                                   grad_out.index_select(0, csr2csc), x,
+                                   "sum"));
+    }
+
+    return {Variable(), Variable(), Variable(), Variable(),
+            Variable(), grad_x,     grad_y};
+  }
+};
+
+class SPMMGAT : public torch::autograd::Function<SPMMGAT> {
+public:
+  static variable_list forward(AutogradContext *ctx,
+                               torch::optional<Variable> opt_row,
+                               Variable rowptr, Variable col,
+                               torch::optional<Variable> opt_colptr,
+                               torch::optional<Variable> opt_csr2csc,
+                               Variable alpha_dst, Variable alpha_src,
+                               Variable mat, double negative_slope,
+                               bool return_attention) {
+
+    if (torch::autograd::any_variable_requires_grad({alpha_src, mat})) {
+      AT_ASSERTM(opt_row.has_value(), "Argument `row` is missing");
+      AT_ASSERTM(opt_colptr.has_value(), "Argument `colptr` is missing");
+      AT_ASSERTM(opt_csr2csc.has_value(), "Argument `csr2csc` is missing");
+    }
+
+    auto row = opt_row.has_value() ? opt_row.value() : col;
+    auto colptr = opt_colptr.has_value() ? opt_colptr.value() : col;
+    auto csr2csc = opt_csr2csc.has_value() ? opt_csr2csc.value() : col;
+
+    // The attention coefficients are only materialized if they are needed
+    // for computing gradients or explicitly requested:
+    auto requires_grad = torch::autograd::any_variable_requires_grad(
+        {alpha_dst, alpha_src, mat});
+    auto result =
+        spmm_gat_fw(rowptr, col, alpha_dst, alpha_src, mat, negative_slope,
+                    return_attention || requires_grad);
+    auto out = std::get<0>(result);
+    auto attention = std::get<1>(result).has_value()
+                         ? std::get<1>(result).value()
+                         : torch::empty({0, mat.size(1)}, mat.options());
+    ctx->mark_non_differentiable({attention});
+
+    ctx->saved_data["negative_slope"] = negative_slope;
+    ctx->save_for_backward({row, rowptr, col, colptr, csr2csc, alpha_dst,
+                            alpha_src, mat, out, attention});
+    return {out, attention};
+  }
+
+  static variable_list backward(AutogradContext *ctx, variable_list grad_outs) {
+    auto grad_out = grad_outs[0].contiguous();
+    auto negative_slope = ctx->saved_data["negative_slope"].toDouble();
+    auto saved = ctx->get_saved_variables();
+    auto row = saved[0], rowptr = saved[1], col = saved[2], colptr = saved[3],
+         csr2csc = saved[4], alpha_dst = saved[5], alpha_src = saved[6],
+         mat = saved[7], out = saved[8], attention = saved[9];
+
+    auto grad_alpha_dst = Variable(), grad_alpha_src = Variable();
+    if (torch::autograd::any_variable_requires_grad({alpha_dst, alpha_src})) {
+      auto result = spmm_gat_bw(rowptr, col, alpha_dst, alpha_src, mat, out,
+                                attention, grad_out, negative_slope);
+      grad_alpha_dst = std::get<0>(result);
+      grad_alpha_src = torch::zeros_like(alpha_src).index_add_(
+          0, col, std::get<1>(result));
+    }
+
+    auto grad_mat = Variable();
+    if (torch::autograd::any_variable_requires_grad({mat})) {
+      grad_mat = std::get<0>(spmm_fw(colptr, row.index_select(0, csr2csc),
+                                     attention.index_select(0, csr2csc),
+                                     grad_out, "sum"));
+    }
+
+    return {Variable(), Variable(), Variable(), Variable(), Variable(),
+            grad_alpha_dst, grad_alpha_src, grad_mat, Variable(), Variable()};
+  }
+};
+
 SPARSE_API torch::Tensor spmm_sum(torch::optional<torch::Tensor> opt_row,
                        torch::Tensor rowptr, torch::Tensor col,
                        torch::optional<torch::Tensor> opt_value,
@@ -341,8 +551,30 @@ spmm_max(torch::Tensor rowptr, torch::Tensor col,
   return std::make_tuple(result[0], result[1]);
 }
 
+SPARSE_API torch::Tensor sddmm(torch::optional<torch::Tensor> opt_row,
+                                torch::Tensor rowptr, torch::Tensor col,
+                                torch::optional<torch::Tensor> opt_colptr,
+                                torch::optional<torch::Tensor> opt_csr2csc,
+                                torch::Tensor x, torch::Tensor y) {
+  return SDDMM::apply(opt_row, rowptr, col, opt_colptr, opt_csr2csc, x, y)[0];
+}
+
+SPARSE_API std::tuple<torch::Tensor, torch::Tensor>
+spmm_gat(torch::optional<torch::Tensor> opt_row, torch::Tensor rowptr,
+         torch::Tensor col, torch::optional<torch::Tensor> opt_colptr,
+         torch::optional<torch::Tensor> opt_csr2csc, torch::Tensor alpha_dst,
+         torch::Tensor alpha_src, torch::Tensor mat, double negative_slope,
+         bool return_attention) {
+  auto result =
+      SPMMGAT::apply(opt_row, rowptr, col, opt_colptr, opt_csr2csc, alpha_dst,
+                     alpha_src, mat, negative_slope, return_attention);
+  return std::make_tuple(result[0], result[1]);
+}
+
 static auto registry = torch::RegisterOperators()
                            .op("torch_sparse::spmm_sum", &spmm_sum)
                            .op("torch_sparse::spmm_mean", &spmm_mean)
                            .op("torch_sparse::spmm_min", &spmm_min)
-                           .op("torch_sparse::spmm_max", &spmm_max);
+                           .op("torch_sparse::spmm_max", &spmm_max)
+                           .op("torch_sparse::sddmm", &sddmm)
+                           .op("torch_sparse::spmm_gat", &spmm_gat);
@@ -54,6 +54,8 @@ def get_extensions():
             define_macros += [('MTMETIS_64BIT_WEIGHTS', None)]
             define_macros += [('MTMETIS_64BIT_PARTITIONS', None)]
             libraries += ['mtmetis', 'wildriver']
+        if sys.platform.startswith('linux'):
+            libraries += ['rt']  # `shm_open` needs librt on glibc < 2.34.
 
         extra_compile_args = {'cxx': ['-O2']}
         if not os.name == 'nt':  # Not on Windows:
@@ -31,3 +31,28 @@ def test_add(dtype, device):
         return add(A, B)
 
     jit_add(A, B)
+
+
+@pytest.mark.parametrize('device', devices)
+def test_add_duplicates_and_grad(device):
+    # `A` contains a duplicated entry and has fewer rows than `B`:
+    rowA = torch.tensor([0, 0, 0, 1], device=device)
+    colA = torch.tensor([0, 2, 2, 1], device=device)
+    valueA = torch.tensor([1., 2., 3., 4.], device=device, requires_grad=True)
+    A = SparseTensor(row=rowA, col=colA, value=valueA, sparse_sizes=(2, 3))
+
+    rowB = torch.tensor([0, 2, 2], device=device)
+    colB = torch.tensor([2, 0, 3], device=device)
+    valueB = torch.tensor([5., 6., 7.], device=device, requires_grad=True)
+    B = SparseTensor(row=rowB, col=colB, value=valueB, sparse_sizes=(3, 4))
+
+    C = A + B
+    assert C.sparse_sizes() == (3, 4)
+    rowC, colC, valueC = C.coo()
+    assert rowC.tolist() == [0, 0, 1, 2, 2]
+    assert colC.tolist() == [0, 2, 1, 0, 3]
+    assert valueC.tolist() == [1, 10, 4, 6, 7]
+
+    valueC.backward(torch.arange(5., device=device))
+    assert valueA.grad.tolist() == [0, 1, 1, 2]
+    assert valueB.grad.tolist() == [1, 3, 4]
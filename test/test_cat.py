@@ -46,3 +46,23 @@ def test_cat(device):
     assert out.storage.has_row()
     assert out.storage.has_rowptr()
     assert out.storage.num_cached_keys() == 5
+
+
+@pytest.mark.parametrize('device', devices)
+def test_cat_diag_many(device):
+    mats, dense = [], []
+    for i in range(1, 20):
+        mat = torch.randint(0, 2, (i % 4 + 1, i % 3 + 1), device=device)
+        mats.append(SparseTensor.from_dense(mat.float()).fill_cache_())
+        dense.append(mat)
+
+    out = cat(mats, dim=(0, 1))
+    assert out.to_dense().tolist() == torch.block_diag(*dense).tolist()
+
+    # Cached CSR and CSC information needs to match a fresh computation:
+    row, col, _ = out.coo()
+    expected = SparseTensor(row=row, col=col, sparse_sizes=out.sparse_sizes())
+    expected.fill_cache_()
+    for key in ['rowptr', 'colptr', 'csr2csc', 'csc2csr']:
+        assert getattr(out.storage, f'_{key}').tolist() == getattr(
+            expected.storage, f'_{key}').tolist()
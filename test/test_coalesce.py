@@ -31,3 +31,29 @@ def test_coalesce_max():
     index, value = coalesce(index, value, m=3, n=2, op='max')
     assert index.tolist() == [[0, 1, 1, 2], [1, 0, 1, 0]]
     assert value.tolist() == [[4, 5], [6, 7], [3, 4], [5, 6]]
+
+
+def test_coalesce_large_sizes():
+    # `row * n + col` would overflow for these sparse sizes:
+    n = 2**62
+    row = torch.tensor([0, 0, 0, 1, 1])
+    col = torch.tensor([1, n - 1, n - 1, 0, n - 1])
+    index = torch.stack([row, col], dim=0)
+    value = torch.tensor([1., 2., 4., 8., 16.])
+
+    index, value = coalesce(index, value, m=2, n=n, op='mean')
+    assert index.tolist() == [[0, 0, 1, 1], [1, n - 1, 0, n - 1]]
+    assert value.tolist() == [1, 3, 8, 16]
+
+
+def test_coalesce_large_sizes_unsorted():
+    # `row * n + col` would overflow for these sparse sizes:
+    n = 2**62
+    row = torch.tensor([3, 1, 0, 3, 0, 1])
+    col = torch.tensor([0, n - 1, n - 1, 0, 1, 2])
+    index = torch.stack([row, col], dim=0)
+    value = torch.tensor([1., 2., 4., 8., 16., 32.])
+
+    index, value = coalesce(index, value, m=4, n=n)
+    assert index.tolist() == [[0, 0, 1, 1, 3], [1, n - 1, 2, n - 1, 0]]
+    assert value.tolist() == [16, 4, 32, 2, 9]
@@ -0,0 +1,63 @@
+import torch
+from torch_sparse import (SparseTensor, compress, compressed_sample_adj,
+                          compressed_spmm, decompress)
+from torch_sparse.matmul import matmul
+
+
+def test_compress():
+    row = torch.tensor([0, 0, 0, 1, 1, 3, 3])
+    col = torch.tensor([0, 5, 300, 2, 70000, 1, 2**40])
+    adj = SparseTensor(row=row, col=col)
+
+    rowptr, byteptr, data = compress(adj)
+    assert data.dtype == torch.uint8
+    assert byteptr.tolist() == [0, 4, 8, 8, 15]
+
+    out = decompress(rowptr, byteptr, data, sparse_sizes=adj.sparse_sizes())
+    assert out.storage.col().tolist() == col.tolist()
+
+
+def test_compressed_spmm():
+    adj = SparseTensor.from_dense(torch.randn(10, 8).relu())
+    value = adj.storage.value()
+    other = torch.randn(8, 4)
+
+    rowptr, byteptr, data = compress(adj)
+    for reduce in ['sum', 'mean']:
+        out = compressed_spmm(rowptr, byteptr, data, value, other, reduce)
+        assert torch.allclose(out, matmul(adj, other, reduce), atol=1e-6)
+
+
+def test_compressed_sample_adj():
+    row = torch.tensor([0, 0, 0, 1, 1, 2, 2, 2, 2, 3, 4, 4, 5, 5])
+    col = torch.tensor([1, 2, 3, 0, 2, 0, 1, 4, 5, 0, 2, 5, 2, 4])
+    value = torch.arange(row.size(0))
+    adj_t = SparseTensor(row=row, col=col, sparse_sizes=(6, 6))
+    rowptr, byteptr, data = compress(adj_t)
+
+    out, n_id = compressed_sample_adj(rowptr, byteptr, data, value,
+                                      torch.arange(2, 6), num_neighbors=-1)
+    assert n_id.tolist() == [2, 3, 4, 5, 0, 1]
+    row, col, val = out.coo()
+    assert row.tolist() == [0, 0, 0, 0, 1, 2, 2, 3, 3]
+    assert col.tolist() == [2, 3, 4, 5, 4, 0, 3, 0, 2]
+    assert val.tolist() == [7, 8, 5, 6, 9, 10, 11, 12, 13]
+
+    out, n_id = compressed_sample_adj(rowptr, byteptr, data, value,
+                                      torch.arange(2, 6), num_neighbors=2)
+    assert out.nnz() == 7
+
+
+def test_compressed_sample_adj_without_replacement():
+    row = torch.arange(2).repeat_interleave(100)
+    col = torch.cat([torch.arange(100), torch.arange(100, 300, 2)])
+    adj_t = SparseTensor(row=row, col=col, sparse_sizes=(2, 300))
+    rowptr, byteptr, data = compress(adj_t)
+
+    for num_neighbors in [10, 70]:
+        out, n_id = compressed_sample_adj(rowptr, byteptr, data, None,
+                                          torch.arange(2), num_neighbors)
+        row_out, col_out, _ = out.coo()
+        assert out.nnz() == 2 * num_neighbors
+        assert n_id[col_out].unique().numel() == 2 * num_neighbors
+        assert bool((n_id[col_out] < 100).eq(row_out == 0).all())
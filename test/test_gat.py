@@ -0,0 +1,49 @@
+from itertools import product
+
+import pytest
+import torch
+import torch.nn.functional as F
+from torch_scatter import scatter_add, scatter_softmax
+from torch_sparse import SparseTensor, gat_spmm
+
+from .utils import grad_dtypes
+
+
+@pytest.mark.parametrize('dtype,heads', product(grad_dtypes, [None, 3]))
+def test_gat_spmm(dtype, heads):
+    src = torch.randn((10, 8))
+    src[2:4, :] = 0  # Remove multiple rows.
+    src[:, 2:4] = 0  # Remove multiple columns.
+    src = SparseTensor.from_dense(src)
+    row, col, _ = src.coo()
+
+    size = () if heads is None else (heads, )
+    alpha_dst = torch.randn((10, ) + size, dtype=dtype, requires_grad=True)
+    alpha_src = torch.randn((8, ) + size, dtype=dtype, requires_grad=True)
+    x = torch.randn((8, ) + size + (16, ), dtype=dtype, requires_grad=True)
+
+    # Compute the reference in full precision:
+    alpha_dst_ref = alpha_dst.detach().double().requires_grad_()
+    alpha_src_ref = alpha_src.detach().double().requires_grad_()
+    x_ref = x.detach().double().requires_grad_()
+    logit = F.leaky_relu(alpha_dst_ref[row] + alpha_src_ref[col], 0.2)
+    attention = scatter_softmax(logit, row, dim=0)
+    expected = scatter_add(attention.unsqueeze(-1) * x_ref[col], row, dim=0,
+                           dim_size=10)
+    grad_out = torch.randn_like(expected)
+    expected.backward(grad_out)
+
+    out, _ = gat_spmm(src, alpha_dst, alpha_src, x, negative_slope=0.2)
+    out.backward(grad_out.to(dtype))
+
+    assert out.size() == expected.size()
+    assert torch.allclose(expected, out.double(), atol=1e-2)
+    assert torch.allclose(alpha_dst_ref.grad, alpha_dst.grad.double(),
+                          atol=1e-2, rtol=1e-2)
+    assert torch.allclose(alpha_src_ref.grad, alpha_src.grad.double(),
+                          atol=1e-2, rtol=1e-2)
+    assert torch.allclose(x_ref.grad, x.grad.double(), atol=1e-2)
+
+    with torch.no_grad():
+        _, out = gat_spmm(src, alpha_dst, alpha_src, x, return_attention=True)
+    assert torch.allclose(attention.detach(), out.double(), atol=1e-2)
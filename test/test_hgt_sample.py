@@ -0,0 +1,63 @@
+import torch
+from torch_sparse import SparseTensor
+
+
+def test_hgt_sample():
+    # Paper-author graph with 4 papers and 100 authors, in which paper 0 has
+    # more than `MAX_NEIGHBORS` authors:
+    row = torch.cat([torch.arange(60), torch.tensor([60, 61, 62, 0, 63])])
+    col = torch.tensor([0] * 60 + [1, 1, 2, 2, 3])
+    writes = SparseTensor(row=col, col=row, sparse_sizes=(4, 100))
+    rev_writes = writes.t()
+
+    colptr_dict, row_dict = {}, {}
+    colptr_dict['author__writes__paper'], row_dict['author__writes__paper'], \
+        _ = writes.csr()
+    colptr_dict['paper__rev_writes__author'], \
+        row_dict['paper__rev_writes__author'], _ = rev_writes.csr()
+
+    input_node_dict = {'paper': torch.tensor([0, 1])}
+    num_samples_dict = {'paper': [2, 2], 'author': [3, 3]}
+
+    node_dict, row_dict_out, col_dict_out, edge_dict = \
+        torch.ops.torch_sparse.hgt_sample(colptr_dict, row_dict,
+                                          input_node_dict, num_samples_dict,
+                                          2)
+
+    paper, author = node_dict['paper'], node_dict['author']
+    assert paper[:2].tolist() == [0, 1]
+    assert paper.unique().numel() == paper.numel() <= 4
+    assert author.unique().numel() == author.numel() == 6
+    # Authors can only be reached via the input papers:
+    assert author.max() < 62
+
+    for rel_type in row_dict_out.keys():
+        src, _, dst = rel_type.split('__')
+        src_node, dst_node = node_dict[src], node_dict[dst]
+        colptr, row = colptr_dict[rel_type], row_dict[rel_type]
+        out_row, out_col = row_dict_out[rel_type], col_dict_out[rel_type]
+        edge = edge_dict[rel_type]
+        assert torch.equal(row[edge], src_node[out_row])
+        assert torch.all(colptr[dst_node[out_col]] <= edge)
+        assert torch.all(edge < colptr[dst_node[out_col] + 1])
+
+
+def test_hgt_sample_source_only_type():
+    # Authors are never a destination, so that their state is kept sparse:
+    row = torch.tensor([10**6, 5, 7, 10**6, 9])
+    col = torch.tensor([0, 0, 1, 1, 2])
+    writes = SparseTensor(row=col, col=row, sparse_sizes=(3, 10**6 + 1))
+    colptr, row, _ = writes.csr()
+
+    node_dict, row_dict_out, col_dict_out, edge_dict = \
+        torch.ops.torch_sparse.hgt_sample(
+            {'author__writes__paper': colptr},
+            {'author__writes__paper': row}, {'paper': torch.tensor([0, 1])},
+            {'paper': [0], 'author': [3]}, 1)
+
+    author = node_dict['author']
+    assert sorted(author.tolist()) == [5, 7, 10**6]
+    edge = edge_dict['author__writes__paper']
+    out_row = row_dict_out['author__writes__paper']
+    assert edge.numel() == 4
+    assert torch.equal(row[edge], author[out_row])
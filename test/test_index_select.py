@@ -0,0 +1,35 @@
+from itertools import product
+
+import pytest
+import torch
+from torch_sparse.tensor import SparseTensor
+
+from .utils import devices, dtypes
+
+
+@pytest.mark.parametrize('dtype,device', product(dtypes, devices))
+def test_index_select(dtype, device):
+    mat = torch.randint(-5, 5, (6, 5), device=device).to(dtype)
+    mat[1, :] = 0  # Remove a row.
+    mat[:, 3] = 0  # Remove a column.
+    src = SparseTensor.from_dense(mat)
+
+    for idx in [[4, 1, 1, 0], [0, 2, 3], []]:
+        idx = torch.tensor(idx, dtype=torch.long, device=device)
+
+        out = src.index_select(0, idx)
+        assert out.sizes() == [idx.numel(), 5]
+        assert out.to_dense().tolist() == mat[idx].tolist()
+
+        out = src.index_select(1, idx)
+        assert out.sizes() == [6, idx.numel()]
+        assert out.to_dense().tolist() == mat[:, idx].tolist()
+        assert out.storage.is_coalesced()
+
+    row_mask = torch.tensor([1, 0, 1, 1, 0, 1], device=device).bool()
+    out = src.masked_select(0, row_mask)
+    assert out.to_dense().tolist() == mat[row_mask].tolist()
+
+    col_mask = torch.tensor([0, 1, 1, 0, 1], device=device).bool()
+    out = src.masked_select(1, col_mask)
+    assert out.to_dense().tolist() == mat[:, col_mask].tolist()
@@ -0,0 +1,25 @@
+import torch
+from torch_sparse import SparseTensor, ladies_sample
+
+
+def test_ladies_sample():
+    dense = (torch.rand(100, 100) < 0.1).float()
+    adj_t = SparseTensor.from_dense(dense)
+    input_node = torch.tensor([0, 1, 2])
+
+    nodes, adjs = ladies_sample(adj_t, input_node, [10, 5])
+    assert len(nodes) == 3 and len(adjs) == 2
+    assert nodes[0].tolist() == [0, 1, 2]
+    assert nodes[1].numel() <= 10 and nodes[2].numel() <= 5
+
+    for i, adj in enumerate(adjs):
+        assert adj.sparse_sizes() == (nodes[i].numel(), nodes[i + 1].numel())
+        row, col, value = adj.coo()
+        # Every sampled edge exists in the original adjacency:
+        assert dense[nodes[i][row], nodes[i + 1][col]].sum() == row.numel()
+        assert torch.all(value > 0)
+
+    # Without subsampling, blocks hold the full neighborhoods:
+    nodes, adjs = ladies_sample(adj_t, input_node, [-1])
+    assert adjs[0].nnz() == adj_t[input_node].nnz()
+    assert torch.all(adjs[0].storage.value() == 1)
@@ -44,6 +44,108 @@ def test_spmm(dtype, device, reduce):
     assert torch.allclose(expected_grad_other, other.grad, atol=1e-2)
 
 
+@pytest.mark.parametrize('dtype,device,reduce',
+                         product(grad_dtypes, devices, reductions))
+def test_multi_head_spmm(dtype, device, reduce):
+    src = torch.randn((10, 8), dtype=dtype, device=device)
+    src[2:4, :] = 0  # Remove multiple rows.
+    src[:, 2:4] = 0  # Remove multiple columns.
+    row, col = src.nonzero().t()
+    value = torch.randn((row.numel(), 3), dtype=dtype, device=device,
+                        requires_grad=True)
+    src = SparseTensor(row=row, col=col, value=value, sparse_sizes=(10, 8))
+
+    other = torch.randn((8, 3, 4), dtype=dtype, device=device,
+                        requires_grad=True)
+
+    src_col = other.index_select(0, col) * value.unsqueeze(-1)
+    expected = torch_scatter.scatter(src_col, row, dim=0, dim_size=10,
+                                     reduce=reduce)
+    if reduce == 'min':
+        expected[expected > 1000] = 0
+    if reduce == 'max':
+        expected[expected < -1000] = 0
+
+    grad_out = torch.randn_like(expected)
+
+    expected.backward(grad_out)
+    expected_grad_value = value.grad
+    value.grad = None
+    expected_grad_other = other.grad
+    other.grad = None
+
+    out = matmul(src, other, reduce)
+    out.backward(grad_out)
+
+    assert out.size() == (10, 3, 4)
+    assert torch.allclose(expected, out, atol=1e-2)
+    assert torch.allclose(expected_grad_value, value.grad, atol=1e-2)
+    assert torch.allclose(expected_grad_other, other.grad, atol=1e-2)
+
+
+@pytest.mark.parametrize('dtype,reduce',
+                         product([torch.float, torch.double], ['sum', 'mean']))
+def test_sell_spmm(dtype, reduce):
+    mat = torch.randn((21, 9), dtype=dtype)
+    mat[torch.rand(21, 9) < 0.6] = 0  # Rows of varying length.
+    mat[5] = 0  # Remove a row.
+    src = SparseTensor.from_dense(mat)
+    other = torch.randn((2, 9, 4), dtype=dtype)
+
+    expected = matmul(src, other, reduce)
+    perm, chunkptr, col, eperm = src.storage.sell(chunk_size=4, sigma=8)
+    assert 'sell' in src.storage.cached_keys()
+    assert sorted(perm.tolist()) == list(range(21))
+    assert chunkptr.numel() == 7
+    assert (eperm >= 0).sum() == src.nnz()
+    svalue = src.storage.sell_value()
+    assert svalue[eperm < 0].abs().sum() == 0
+    mask = eperm >= 0
+    assert torch.equal(svalue[mask], src.storage.value()[eperm[mask]])
+
+    out = matmul(src, other, reduce)
+    assert torch.allclose(expected, out)
+    assert src.storage.sell_value().data_ptr() == svalue.data_ptr()
+
+    # Wide features take the row-wise path:
+    other = torch.randn((9, 40), dtype=dtype)
+    assert torch.allclose(matmul(src, other, reduce),
+                          matmul(SparseTensor.from_dense(mat), other, reduce))
+
+    other = torch.randn((2, 9, 4), dtype=dtype)
+    src = src.set_value(None)
+    assert src.storage.has_sell()
+    assert torch.allclose(matmul(src, other, reduce),
+                          matmul(src.fill_value(1.), other, reduce))
+
+
+@pytest.mark.parametrize('dtype,reduce',
+                         product([torch.float, torch.double], ['sum', 'mean']))
+def test_bsr_spmm(dtype, reduce):
+    mat = torch.randn((7, 5), dtype=dtype)
+    mat[0:2, 2:4] = 0  # Remove a block.
+    mat[4:6, :] = 0  # Remove a block row.
+    src = SparseTensor.from_dense(mat)
+    other = torch.randn((2, 5, 3), dtype=dtype)
+
+    expected = matmul(src, other, reduce)
+    browptr, bcol, bvalue = src.to_bsr(2, 2)
+    assert browptr.tolist() == [0, 2, 5, 5, 8]
+    assert bcol.tolist() == [0, 2, 0, 1, 2, 0, 1, 2]
+    assert bvalue.size() == (8, 2, 2)
+    assert bvalue[0].tolist() == mat[0:2, 0:2].tolist()
+    assert 'bsr' in src.storage.cached_keys()
+    assert src.to_bsr(2, 2)[2].data_ptr() == bvalue.data_ptr()
+
+    out = matmul(src, other, reduce)
+    assert torch.allclose(expected, out)
+
+    # Block values get recomputed once values change:
+    src.storage.set_value_(2 * src.storage.value(), layout='coo')
+    assert src.to_bsr(2, 2)[2].data_ptr() != bvalue.data_ptr()
+    assert torch.allclose(matmul(src, other, reduce), 2 * expected)
+
+
 @pytest.mark.parametrize('dtype,device', product(grad_dtypes, devices))
 def test_spspmm(dtype, device):
     src = torch.tensor([[1, 0, 0], [0, 1, 0], [0, 0, 1]], dtype=dtype,
@@ -65,3 +167,23 @@ def test_spspmm(dtype, device):
     rowptr, col, value = out.csr()
     assert rowptr.tolist() == [0, 1, 2, 3]
     assert col.tolist() == [0, 1, 2]
+
+
+@pytest.mark.parametrize('dtype', [torch.half, torch.bfloat16])
+def test_reduced_precision_matmul(dtype):
+    src = torch.randn((10, 8))
+    src[2:4, :] = 0  # Remove multiple rows.
+    src[:, 2:4] = 0  # Remove multiple columns.
+    src = SparseTensor.from_dense(src)
+    other = torch.randn((8, 16))
+
+    expected = matmul(src, other)
+    out = matmul(src.to(dtype), other.to(dtype))
+    assert out.dtype == dtype
+    assert torch.allclose(expected, out.to(torch.float), atol=5e-2, rtol=1e-2)
+
+    expected = matmul(src, src.t()).to_dense()
+    out = matmul(src.to(dtype), src.t().to(dtype))
+    assert out.dtype() == dtype
+    assert torch.allclose(expected, out.to_dense().to(torch.float), atol=5e-2,
+                          rtol=1e-2)
@@ -37,3 +37,38 @@ def test_metis(device, weighted):
                                          weighted=weighted, node_weight=vec)
         assert partptr.numel() == 3
         assert perm.numel() == 6
+
+
+def test_cluster_subgraph():
+    mat = (torch.rand(6, 6) < 0.5).float() * torch.rand(6, 6)
+    src = SparseTensor.from_dense(mat)
+    partptr = torch.tensor([0, 2, 4, 6])
+
+    out, node = src.cluster_subgraph(partptr, torch.tensor([2, 0]))
+    assert node.tolist() == [0, 1, 4, 5]
+    assert torch.allclose(out.to_dense(), mat[node][:, node])
+
+    out, node = src.cluster_subgraph(partptr, torch.tensor([1]))
+    assert node.tolist() == [2, 3]
+    assert torch.allclose(out.to_dense(), mat[2:4, 2:4])
+
+
+@pytest.mark.parametrize('method', ['ldg', 'fennel'])
+def test_stream_partition(method):
+    # Two disconnected cliques:
+    mat = torch.block_diag(torch.ones(6, 6), torch.ones(6, 6))
+    mat = SparseTensor.from_dense(mat)
+
+    for num_workers, node_weight in product([1, 2], [None, torch.ones(12)]):
+        out, partptr, perm = mat.partition(num_parts=2, weighted=True,
+                                           node_weight=node_weight,
+                                           method=method,
+                                           num_workers=num_workers)
+        assert partptr.numel() == 3
+        assert perm.sort()[0].tolist() == list(range(12))
+        assert (partptr[1:] - partptr[:-1]).max() <= 7
+
+    _, partptr, perm = mat.partition(num_parts=2, method='ldg',
+                                     num_workers=1)
+    assert partptr.tolist() == [0, 6, 12]
+    assert perm[:6].sort()[0].tolist() == list(range(6))
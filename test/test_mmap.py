@@ -0,0 +1,66 @@
+import os
+import struct
+
+import pytest
+import torch
+from torch_sparse import (SparseTensor, attach_shared_store,
+                          create_shared_store, load_csr, save_csr,
+                          unlink_shared_store)
+
+
+def test_mmap(tmp_path):
+    path = str(tmp_path / 'adj.bin')
+
+    adj = SparseTensor.from_dense(torch.randn(6, 5).relu())
+    adj.storage.colptr()
+    save_csr(adj, path)
+
+    out = load_csr(path)
+    assert out.sparse_sizes() == adj.sparse_sizes()
+    assert out.storage.has_colptr() and not out.storage.has_csr2csc()
+    assert torch.equal(out.to_dense(), adj.to_dense())
+
+    adj = SparseTensor(row=torch.tensor([0, 0, 2]),
+                       col=torch.tensor([1, 3, 0]), sparse_sizes=(4, 4))
+    save_csr(adj, path)
+
+    out = load_csr(path)
+    assert not out.has_value()
+    assert out.sparse_sizes() == (4, 4)
+    assert out.storage.rowptr().tolist() == [0, 2, 2, 3, 3]
+    assert out.storage.col().tolist() == [1, 3, 0]
+
+
+def test_load_corrupt_csr(tmp_path):
+    path = str(tmp_path / 'adj.bin')
+    adj = SparseTensor.from_dense(torch.randn(6, 5).relu())
+    save_csr(adj, path)
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    # Mismatch between `num_rows` and the size of `rowptr`:
+    with open(path, 'wb') as f:
+        f.write(data[:16] + struct.pack('q', 7) + data[24:])
+    with pytest.raises(RuntimeError):
+        load_csr(path)
+
+    # Truncated sections:
+    with open(path, 'wb') as f:
+        f.write(data[:-64])
+    with pytest.raises(RuntimeError):
+        load_csr(path)
+
+
+def test_shared_store():
+    name = 'torch_sparse_test_{}'.format(os.getpid())
+
+    adj = SparseTensor.from_dense(torch.randn(6, 5).relu())
+    create_shared_store(adj, name)
+    try:
+        out = attach_shared_store(name)
+        assert out.storage.num_cached_keys() == 5
+        assert out.storage.has_row()
+        assert torch.equal(out.to_dense(), adj.to_dense())
+        assert torch.equal(out.storage.csc2csr(), adj.storage.csc2csr())
+    finally:
+        unlink_shared_store(name)
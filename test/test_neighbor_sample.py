@@ -0,0 +1,83 @@
+import pytest
+import torch
+from torch_sparse import SparseTensor, load_csr, save_csr
+from torch_sparse import neighbor_sample_gather, neighbor_sample_loader
+
+
+def to_edge_set(node, row, col):
+    return set(zip(node[row].tolist(), node[col].tolist()))
+
+
+def test_out_of_core_neighbor_sample(tmp_path):
+    path = str(tmp_path / 'adj_t.bin')
+
+    adj = SparseTensor.from_dense((torch.rand(50, 50) < 0.1).float())
+    save_csr(adj.t(), path)
+    colptr, row, _ = load_csr(path).csr()
+    input_node = torch.tensor([0, 10, 20])
+
+    for directed in [True, False]:
+        expected = torch.ops.torch_sparse.neighbor_sample(
+            colptr, row, input_node, [-1, -1], False, directed)
+        expected = to_edge_set(*expected[:3])
+        for num_io_threads in [0, 2]:
+            out = torch.ops.torch_sparse.out_of_core_neighbor_sample(
+                colptr, row, input_node, [-1, -1], False, directed,
+                num_io_threads)
+            assert out[0][:3].tolist() == [0, 10, 20]
+            assert to_edge_set(*out[:3]) == expected
+
+    out = torch.ops.torch_sparse.out_of_core_neighbor_sample(
+        colptr, row, input_node, [2, 2], False, True, 2)
+    assert out[1].numel() <= 3 * 2 + 3 * 2 * 2
+
+
+def test_neighbor_sample_loader():
+    adj_t = SparseTensor.from_dense((torch.rand(50, 50) < 0.1).float())
+    colptr, row, _ = adj_t.csr()
+    input_node = torch.randperm(50)[:23]
+
+    for num_workers in [1, 3]:
+        loader = neighbor_sample_loader(adj_t, input_node, [-1, -1],
+                                        batch_size=5, num_workers=num_workers,
+                                        queue_size=2)
+        outs = list(loader)
+        assert len(outs) == 5
+        for i, out in enumerate(outs):
+            batch = input_node[5 * i:5 * (i + 1)]
+            assert out[0][:batch.numel()].tolist() == batch.tolist()
+            expected = torch.ops.torch_sparse.neighbor_sample(
+                colptr, row, batch, [-1, -1], False, True)
+            assert to_edge_set(*out[:3]) == to_edge_set(*expected[:3])
+
+
+def test_neighbor_sample_gather():
+    adj_t = SparseTensor.from_dense((torch.rand(50, 50) < 0.1).float())
+    colptr, row, _ = adj_t.csr()
+    x = torch.randn(50, 8)
+    edge_attr = torch.randn(adj_t.nnz(), 3)
+    input_node = torch.tensor([0, 10, 20])
+
+    node, _, _, edge, x_out, edge_out = neighbor_sample_gather(
+        adj_t, input_node, [-1, -1], x=x, edge_attr=edge_attr)
+    assert torch.equal(x_out, x[node])
+    assert torch.equal(edge_out, edge_attr[edge])
+
+    x_buf = torch.empty(50, 8).share_memory_()
+    edge_buf = torch.empty(adj_t.nnz(), 3).share_memory_()
+    node, _, _, edge, x_out, edge_out = neighbor_sample_gather(
+        adj_t, input_node, [-1, -1], x=x, x_out=x_buf, edge_attr=edge_attr,
+        edge_out=edge_buf)
+    assert x_out.data_ptr() == x_buf.data_ptr()
+    assert torch.equal(x_out, x[node])
+    assert torch.equal(edge_buf[:edge.numel()], edge_attr[edge])
+
+    out = neighbor_sample_gather(adj_t, input_node, [2])
+    assert out[4] is None and out[5] is None
+
+    # Features need to cover every node and edge:
+    with pytest.raises(RuntimeError):
+        neighbor_sample_gather(adj_t, input_node, [-1], x=x[:10])
+    with pytest.raises(RuntimeError):
+        neighbor_sample_gather(adj_t, input_node, [-1],
+                               edge_attr=edge_attr[:1])
@@ -0,0 +1,49 @@
+import pytest
+import torch
+from torch_sparse import SparseTensor, matmul, padded_index_select, padded_spmm
+
+
+def test_padded_index_select():
+    row = torch.tensor([0, 0, 0, 0, 1, 1, 1, 2, 2, 3])
+    col = torch.tensor([0, 1, 2, 3, 0, 2, 3, 1, 3, 2])
+    adj = SparseTensor(row=row, col=col)
+    binptr = torch.tensor([0, 3, 5])
+
+    data = adj.padded_index(binptr)
+    node_perm, row_perm, col_perm, mask, node_size, edge_size = data
+
+    assert node_perm.tolist() == [2, 3, 0, 1]
+    assert row_perm.tolist() == [2, 2, 3, -1, 0, 0, 0, 0, 1, 1, 1, -1]
+    assert col_perm.tolist() == [1, 3, 2, -1, 0, 1, 2, 3, 0, 2, 3, -1]
+    assert mask.long().tolist() == [0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1]
+    assert node_size == [2, 2]
+    assert edge_size == [4, 8]
+
+    x = torch.tensor([[0.], [1.], [2.], [3.]], requires_grad=True)
+    out = padded_index_select(x, col_perm, fill_value=0.)
+    assert out.flatten().tolist() == [1, 3, 2, 0, 0, 1, 2, 3, 0, 2, 3, 0]
+
+    grad_out = torch.arange(12, dtype=torch.float).view(-1, 1)
+    out.backward(grad_out)
+    assert x.grad.flatten().tolist() == [12, 5, 17, 18]
+
+
+@pytest.mark.parametrize('reduce', ['sum', 'mean'])
+def test_padded_spmm(reduce):
+    mat = torch.randn(30, 20)
+    mat[torch.rand(30, 20) < 0.7] = 0
+    mat[3] = 0  # Remove a row.
+    src = SparseTensor.from_dense(mat)
+    other = torch.randn(20, 8, requires_grad=True)
+    binptr = torch.tensor([0, 4, 8, 12])
+
+    expected = matmul(src, other, reduce)
+    out = padded_spmm(src, other, binptr, reduce)
+    assert torch.allclose(out, expected, atol=1e-6)
+
+    out = padded_spmm(src.set_value(None), other, binptr, reduce)
+    assert torch.allclose(out, matmul(src.fill_value(1.), other, reduce),
+                          atol=1e-6)
+
+    out.sum().backward()
+    assert other.grad is not None
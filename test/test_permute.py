@@ -15,3 +15,18 @@ def test_permute(device):
     assert row.tolist() == [0, 1, 1, 2, 2]
     assert col.tolist() == [1, 0, 1, 0, 2]
     assert value.tolist() == [3, 2, 1, 4, 5]
+
+
+@pytest.mark.parametrize('device', devices)
+def test_permute_dense(device):
+    mat = torch.randint(0, 3, (8, 8), device=device).float()
+    perm = torch.randperm(8, device=device)
+    adj = SparseTensor.from_dense(mat)
+
+    out = adj.permute(perm)
+    assert out.storage.is_coalesced()
+    assert out.to_dense().tolist() == mat[perm][:, perm].tolist()
+
+    out = adj.set_value(None).permute(perm)
+    assert out.storage.value() is None
+    assert out.to_dense().tolist() == (mat[perm][:, perm] > 0).tolist()
@@ -33,3 +33,21 @@ def test_sample_adj():
     out, n_id = sample_adj(adj_t, torch.arange(2, 6), num_neighbors=2,
                            replace=False)
     assert out.nnz() == 7  # node 3 has only one edge...
+
+
+def test_sample_adj_without_replacement():
+    rowptr = torch.tensor([0, 20, 120])
+    col = torch.cat([torch.arange(20), torch.arange(100)])
+
+    for num_neighbors in [10, 70]:
+        out_rowptr, out_col, n_id, e_id = torch.ops.torch_sparse.sample_adj(
+            rowptr, col, torch.arange(2), num_neighbors, False)
+        count = min(num_neighbors, 20)
+        assert out_rowptr.tolist() == [0, count, count + num_neighbors]
+        assert n_id[:2].tolist() == [0, 1]
+        assert n_id.unique().numel() == n_id.numel()
+        assert torch.equal(n_id[out_col], col[e_id])
+        for i in range(2):
+            e = e_id[out_rowptr[i]:out_rowptr[i + 1]]
+            assert e.unique().numel() == e.numel()
+            assert e.min() >= rowptr[i] and e.max() < rowptr[i + 1]
@@ -0,0 +1,35 @@
+from itertools import product
+
+import pytest
+import torch
+from torch_sparse import SparseTensor, sddmm
+
+from .utils import grad_dtypes
+
+
+@pytest.mark.parametrize('dtype,heads', product(grad_dtypes, [None, 3]))
+def test_sddmm(dtype, heads):
+    src = torch.randn((10, 8))
+    src[2:4, :] = 0  # Remove multiple rows.
+    src[:, 2:4] = 0  # Remove multiple columns.
+    src = SparseTensor.from_dense(src)
+    row, col, _ = src.coo()
+
+    size = (16, ) if heads is None else (heads, 16)
+    x = torch.randn((10, ) + size, dtype=dtype, requires_grad=True)
+    y = torch.randn((8, ) + size, dtype=dtype, requires_grad=True)
+
+    # Compute the reference in full precision:
+    x_ref = x.detach().double().requires_grad_()
+    y_ref = y.detach().double().requires_grad_()
+    expected = (x_ref[row] * y_ref[col]).sum(dim=-1)
+    grad_out = torch.randn_like(expected)
+    expected.backward(grad_out)
+
+    out = sddmm(src, x, y)
+    out.backward(grad_out.to(dtype))
+
+    assert out.size() == expected.size()
+    assert torch.allclose(expected, out.double(), atol=1e-2)
+    assert torch.allclose(x_ref.grad, x.grad.double(), atol=1e-2)
+    assert torch.allclose(y_ref.grad, y.grad.double(), atol=1e-2)
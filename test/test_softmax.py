@@ -0,0 +1,51 @@
+from itertools import product
+
+import pytest
+import torch
+from torch_scatter import scatter_softmax
+from torch_sparse import SparseTensor, softmax
+
+from .utils import grad_dtypes
+
+
+@pytest.mark.parametrize('dtype,heads', product(grad_dtypes, [None, 3]))
+def test_softmax(dtype, heads):
+    row = torch.tensor([0, 0, 0, 1, 1, 3, 3, 3, 3])
+    col = torch.tensor([0, 1, 3, 0, 2, 0, 1, 2, 3])
+    size = (row.numel(), ) if heads is None else (row.numel(), heads)
+    value = 10 * torch.randn(size, dtype=torch.double)
+
+    value_ref = value.clone().requires_grad_()
+    expected = scatter_softmax(value_ref, row, dim=0)
+    grad_out = torch.randn_like(expected)
+    expected.backward(grad_out)
+
+    value = value.to(dtype).requires_grad_()
+    adj = SparseTensor(row=row, col=col, value=value, sparse_sizes=(4, 4))
+    out = softmax(adj, dim=1).storage.value()
+    out.backward(grad_out.to(dtype))
+
+    assert torch.allclose(expected, out.double(), atol=1e-2)
+    assert torch.allclose(value_ref.grad, value.grad.double(), atol=1e-2)
+
+    expected = scatter_softmax(value_ref.detach(), col, dim=0)
+    out = adj.softmax(dim=0).storage.value()
+    assert torch.allclose(expected, out.double(), atol=1e-2)
+
+    value = value.detach().clone()
+    adj = SparseTensor(row=row, col=col, value=value, sparse_sizes=(4, 4))
+    out = adj.softmax(dim=1, inplace=True).storage.value()
+    assert out.data_ptr() == value.data_ptr()
+    expected = scatter_softmax(value_ref.detach(), row, dim=0)
+    assert torch.allclose(expected, out.double(), atol=1e-2)
+
+
+def test_softmax_without_value():
+    row = torch.tensor([0, 0, 1, 2, 2, 2])
+    col = torch.tensor([0, 1, 1, 0, 1, 2])
+    adj = SparseTensor(row=row, col=col, sparse_sizes=(3, 3))
+
+    out = adj.softmax(dim=1)
+    assert adj.storage.value() is None
+    expected = torch.tensor([0.5, 0.5, 1., 1 / 3, 1 / 3, 1 / 3])
+    assert torch.allclose(out.storage.value(), expected)
@@ -73,6 +73,47 @@ def test_to_symmetric(device):
     ]
 
 
+def test_to_symmetric_cached_transpose():
+    mat = SparseTensor.from_dense((torch.rand(300, 200) < 0.05).float())
+    expected = torch.zeros(300, 300)
+    expected[:, :200] = mat.to_dense()
+    expected = expected + expected.t()
+
+    assert torch.equal(mat.to_symmetric().to_dense(), expected)
+    mat.storage.fill_cache_()
+    assert torch.equal(mat.to_symmetric().to_dense(), expected)
+
+
+@pytest.mark.parametrize('device', devices)
+def test_to_symmetric_reduce(device):
+    row = torch.tensor([0, 1, 1, 2], device=device)
+    col = torch.tensor([1, 0, 2, 2], device=device)
+    value = torch.tensor([1., 4., 2., 3.], device=device)
+    mat = SparseTensor(row=row, col=col, value=value, sparse_sizes=(3, 3))
+    assert not mat.is_symmetric()
+    assert mat.set_value(None).is_symmetric() is False
+
+    out = mat.to_symmetric(reduce='max')
+    assert out.is_symmetric()
+    assert out.to_dense().tolist() == [
+        [0, 4, 0],
+        [4, 0, 2],
+        [0, 2, 3],
+    ]
+
+    out = mat.set_value(None).to_symmetric()
+    assert out.is_symmetric()
+    assert out.storage.value() is None
+    assert out.storage.rowptr().tolist() == [0, 1, 3, 5]
+    assert out.storage.col().tolist() == [1, 0, 2, 1, 2]
+
+
+def test_is_symmetric_non_square():
+    rowptr = torch.tensor([0, 2, 3])
+    col = torch.tensor([0, 5, 1])
+    assert not torch.ops.torch_sparse.is_symmetric(rowptr, col, None)
+
+
 def test_equal():
     row = torch.tensor([0, 0, 0, 1, 1])
     col = torch.tensor([0, 1, 2, 0, 2])
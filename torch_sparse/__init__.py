@@ -8,7 +8,9 @@ __version__ = '0.6.13'
 for library in [
         '_version', '_convert', '_diag', '_spmm', '_spspmm', '_metis', '_rw',
         '_saint', '_sample', '_ego_sample', '_hgt_sample', '_neighbor_sample',
-        '_relabel'
+        '_relabel', '_softmax', '_spadd', '_coalesce', '_index_select',
+        '_permute', '_cat', '_padding', '_sell', '_bsr', '_compress', '_mmap',
+        '_ladies_sample'
 ]:
     cuda_spec = importlib.machinery.PathFinder().find_spec(
         f'{library}_cuda', [osp.dirname(__file__)])
@@ -49,14 +51,27 @@ from .diag import remove_diag, set_diag, fill_diag, get_diag  # noqa
 from .add import add, add_, add_nnz, add_nnz_  # noqa
 from .mul import mul, mul_, mul_nnz, mul_nnz_  # noqa
 from .reduce import sum, mean, min, max  # noqa
+from .softmax import softmax  # noqa
 from .matmul import matmul  # noqa
+from .sddmm import sddmm  # noqa
+from .gat import gat_spmm  # noqa
+from .bsr import to_bsr  # noqa
 from .cat import cat  # noqa
 from .rw import random_walk  # noqa
-from .metis import partition  # noqa
+from .metis import partition, cluster_subgraph  # noqa
 from .bandwidth import reverse_cuthill_mckee  # noqa
 from .saint import saint_subgraph  # noqa
 from .padding import padded_index, padded_index_select  # noqa
+from .padding import padded_spmm  # noqa
 from .sample import sample, sample_adj  # noqa
+from .neighbor_sample import neighbor_sample_gather  # noqa
+from .neighbor_sample import neighbor_sample_loader  # noqa
+from .ladies_sample import ladies_sample  # noqa
+from .compress import compress, decompress  # noqa
+from .compress import compressed_spmm, compressed_sample_adj  # noqa
+from .mmap import save_csr, load_csr  # noqa
+from .mmap import create_shared_store, attach_shared_store  # noqa
+from .mmap import unlink_shared_store  # noqa
 
 from .convert import to_torch_sparse, from_torch_sparse  # noqa
 from .convert import to_scipy, from_scipy  # noqa
@@ -95,14 +110,32 @@ __all__ = [
     'mean',
     'min',
     'max',
+    'softmax',
     'matmul',
+    'sddmm',
+    'gat_spmm',
+    'to_bsr',
     'cat',
     'random_walk',
     'partition',
+    'cluster_subgraph',
     'reverse_cuthill_mckee',
     'saint_subgraph',
     'padded_index',
     'padded_index_select',
+    'padded_spmm',
+    'neighbor_sample_gather',
+    'neighbor_sample_loader',
+    'ladies_sample',
+    'compress',
+    'decompress',
+    'compressed_spmm',
+    'compressed_sample_adj',
+    'save_csr',
+    'load_csr',
+    'create_shared_store',
+    'attach_shared_store',
+    'unlink_shared_store',
     'to_torch_sparse',
     'from_torch_sparse',
     'to_scipy',
@@ -36,24 +36,41 @@ def add(src, other):  # noqa: F811
         return src.set_value(value, layout='coo')
 
     elif isinstance(other, SparseTensor):
-        rowA, colA, valueA = src.coo()
-        rowB, colB, valueB = other.coo()
-
-        row = torch.cat([rowA, rowB], dim=0)
-        col = torch.cat([colA, colB], dim=0)
-
-        value: Optional[Tensor] = None
-        if valueA is not None and valueB is not None:
-            value = torch.cat([valueA, valueB], dim=0)
-
         M = max(src.size(0), other.size(0))
         N = max(src.size(1), other.size(1))
         sparse_sizes = (M, N)
 
-        out = SparseTensor(row=row, col=col, value=value,
-                           sparse_sizes=sparse_sizes)
-        out = out.coalesce(reduce='sum')
-        return out
+        value: Optional[Tensor] = None
+        if src.is_cuda():
+            rowA, colA, valueA = src.coo()
+            rowB, colB, valueB = other.coo()
+
+            row = torch.cat([rowA, rowB], dim=0)
+            col = torch.cat([colA, colB], dim=0)
+
+            if valueA is not None and valueB is not None:
+                value = torch.cat([valueA, valueB], dim=0)
+
+            out = SparseTensor(row=row, col=col, value=value,
+                               sparse_sizes=sparse_sizes)
+            out = out.coalesce(reduce='sum')
+            return out
+
+        # Merge both (already sorted) CSR representations row by row:
+        rowptrA, colA, valueA = src.csr()
+        rowptrB, colB, valueB = other.csr()
+        rowptr, col, permA, permB = torch.ops.torch_sparse.spadd(
+            rowptrA, colA, rowptrB, colB)
+
+        if valueA is not None and valueB is not None:
+            dtype = torch.promote_types(valueA.dtype, valueB.dtype)
+            size = [col.numel()] + list(valueA.size())[1:]
+            value = torch.zeros(size, dtype=dtype, device=valueA.device)
+            value = value.index_add(0, permA, valueA.to(dtype))
+            value = value.index_add(0, permB, valueB.to(dtype))
+
+        return SparseTensor(row=None, rowptr=rowptr, col=col, value=value,
+                            sparse_sizes=sparse_sizes, is_sorted=True)
 
     else:
         raise NotImplementedError
@@ -0,0 +1,18 @@
+from typing import Tuple
+
+import torch
+from torch_sparse.tensor import SparseTensor
+
+
+def to_bsr(src: SparseTensor, R: int,
+           C: int) -> Tuple[torch.Tensor, torch.Tensor, torch.Tensor]:
+    """Converts :obj:`src` into the blocked CSR (BSR) format with dense
+    blocks of shape :obj:`[R, C]`, and returns the block row pointer, the
+    block column indices and the block values of shape :obj:`[nnzb, R, C]`.
+    The block pattern and values are cached in :obj:`src.storage`, which lets
+    subsequent :meth:`matmul` calls on CPU use a blocked kernel."""
+    browptr, bcol, _ = src.storage.bsr(R, C)
+    return browptr, bcol, src.storage.bsr_value()
+
+
+SparseTensor.to_bsr = to_bsr
@@ -57,6 +57,20 @@ def cat(tensors, dim):  # noqa: F811
         return cat_diag(tensors)
 
 
+def cat_offset(tensors: List[torch.Tensor], offsets: List[int],
+               skip_first: bool = False) -> torch.Tensor:
+    # Concatenates index tensors while shifting them by `offsets`, and drops
+    # the leading entry of all but the first tensor if `skip_first` is set:
+    if not tensors[0].is_cuda:
+        return torch.ops.torch_sparse.cat_offset(tensors, offsets, skip_first)
+
+    outs: List[torch.Tensor] = []
+    for i in range(len(tensors)):
+        tensor = tensors[i][1:] if skip_first and i > 0 else tensors[i]
+        outs.append(tensor + offsets[i])
+    return torch.cat(outs, dim=0)
+
+
 def cat_first(tensors: List[SparseTensor]) -> SparseTensor:
     rows: List[torch.Tensor] = []
     rowptrs: List[torch.Tensor] = []
@@ -64,16 +78,18 @@ def cat_first(tensors: List[SparseTensor]) -> SparseTensor:
     values: List[torch.Tensor] = []
     sparse_sizes: List[int] = [0, 0]
     rowcounts: List[torch.Tensor] = []
+    row_offsets: List[int] = []
+    nnz_offsets: List[int] = []
 
     nnz: int = 0
     for tensor in tensors:
         row = tensor.storage._row
         if row is not None:
-            rows.append(row + sparse_sizes[0])
+            rows.append(row)
 
         rowptr = tensor.storage._rowptr
         if rowptr is not None:
-            rowptrs.append(rowptr[1:] + nnz if len(rowptrs) > 0 else rowptr)
+            rowptrs.append(rowptr)
 
         cols.append(tensor.storage._col)
 
@@ -85,17 +101,20 @@ def cat_first(tensors: List[SparseTensor]) -> SparseTensor:
         if rowcount is not None:
             rowcounts.append(rowcount)
 
+        row_offsets.append(sparse_sizes[0])
+        nnz_offsets.append(nnz)
+
         sparse_sizes[0] += tensor.sparse_size(0)
         sparse_sizes[1] = max(sparse_sizes[1], tensor.sparse_size(1))
         nnz += tensor.nnz()
 
     row: Optional[torch.Tensor] = None
     if len(rows) == len(tensors):
-        row = torch.cat(rows, dim=0)
+        row = cat_offset(rows, row_offsets)
 
     rowptr: Optional[torch.Tensor] = None
     if len(rowptrs) == len(tensors):
-        rowptr = torch.cat(rowptrs, dim=0)
+        rowptr = cat_offset(rowptrs, nnz_offsets, skip_first=True)
 
     col = torch.cat(cols, dim=0)
 
@@ -121,30 +140,35 @@ def cat_second(tensors: List[SparseTensor]) -> SparseTensor:
     sparse_sizes: List[int] = [0, 0]
     colptrs: List[torch.Tensor] = []
     colcounts: List[torch.Tensor] = []
+    col_offsets: List[int] = []
+    nnz_offsets: List[int] = []
 
     nnz: int = 0
     for tensor in tensors:
         row, col, value = tensor.coo()
         rows.append(row)
-        cols.append(tensor.storage._col + sparse_sizes[1])
+        cols.append(col)
 
         if value is not None:
             values.append(value)
 
         colptr = tensor.storage._colptr
         if colptr is not None:
-            colptrs.append(colptr[1:] + nnz if len(colptrs) > 0 else colptr)
+            colptrs.append(colptr)
 
         colcount = tensor.storage._colcount
         if colcount is not None:
             colcounts.append(colcount)
 
+        col_offsets.append(sparse_sizes[1])
+        nnz_offsets.append(nnz)
+
         sparse_sizes[0] = max(sparse_sizes[0], tensor.sparse_size(0))
         sparse_sizes[1] += tensor.sparse_size(1)
         nnz += tensor.nnz()
 
     row = torch.cat(rows, dim=0)
-    col = torch.cat(cols, dim=0)
+    col = cat_offset(cols, col_offsets)
 
     value: Optional[torch.Tensor] = None
     if len(values) == len(tensors):
@@ -152,7 +176,7 @@ def cat_second(tensors: List[SparseTensor]) -> SparseTensor:
 
     colptr: Optional[torch.Tensor] = None
     if len(colptrs) == len(tensors):
-        colptr = torch.cat(colptrs, dim=0)
+        colptr = cat_offset(colptrs, nnz_offsets, skip_first=True)
 
     colcount: Optional[torch.Tensor] = None
     if len(colcounts) == len(tensors):
@@ -178,18 +202,21 @@ def cat_diag(tensors: List[SparseTensor]) -> SparseTensor:
     colcounts: List[torch.Tensor] = []
     csr2cscs: List[torch.Tensor] = []
     csc2csrs: List[torch.Tensor] = []
+    row_offsets: List[int] = []
+    col_offsets: List[int] = []
+    nnz_offsets: List[int] = []
 
     nnz: int = 0
     for tensor in tensors:
         row = tensor.storage._row
         if row is not None:
-            rows.append(row + sparse_sizes[0])
+            rows.append(row)
 
         rowptr = tensor.storage._rowptr
         if rowptr is not None:
-            rowptrs.append(rowptr[1:] + nnz if len(rowptrs) > 0 else rowptr)
+            rowptrs.append(rowptr)
 
-        cols.append(tensor.storage._col + sparse_sizes[1])
+        cols.append(tensor.storage._col)
 
         value = tensor.storage._value
         if value is not None:
@@ -201,7 +228,7 @@ def cat_diag(tensors: List[SparseTensor]) -> SparseTensor:
 
         colptr = tensor.storage._colptr
         if colptr is not None:
-            colptrs.append(colptr[1:] + nnz if len(colptrs) > 0 else colptr)
+            colptrs.append(colptr)
 
         colcount = tensor.storage._colcount
         if colcount is not None:
@@ -209,11 +236,15 @@ def cat_diag(tensors: List[SparseTensor]) -> SparseTensor:
 
         csr2csc = tensor.storage._csr2csc
         if csr2csc is not None:
-            csr2cscs.append(csr2csc + nnz)
+            csr2cscs.append(csr2csc)
 
         csc2csr = tensor.storage._csc2csr
         if csc2csr is not None:
-            csc2csrs.append(csc2csr + nnz)
+            csc2csrs.append(csc2csr)
+
+        row_offsets.append(sparse_sizes[0])
+        col_offsets.append(sparse_sizes[1])
+        nnz_offsets.append(nnz)
 
         sparse_sizes[0] += tensor.sparse_size(0)
         sparse_sizes[1] += tensor.sparse_size(1)
@@ -221,13 +252,13 @@ def cat_diag(tensors: List[SparseTensor]) -> SparseTensor:
 
     row: Optional[torch.Tensor] = None
     if len(rows) == len(tensors):
-        row = torch.cat(rows, dim=0)
+        row = cat_offset(rows, row_offsets)
 
     rowptr: Optional[torch.Tensor] = None
     if len(rowptrs) == len(tensors):
-        rowptr = torch.cat(rowptrs, dim=0)
+        rowptr = cat_offset(rowptrs, nnz_offsets, skip_first=True)
 
-    col = torch.cat(cols, dim=0)
+    col = cat_offset(cols, col_offsets)
 
     value: Optional[torch.Tensor] = None
     if len(values) == len(tensors):
@@ -239,7 +270,7 @@ def cat_diag(tensors: List[SparseTensor]) -> SparseTensor:
 
     colptr: Optional[torch.Tensor] = None
     if len(colptrs) == len(tensors):
-        colptr = torch.cat(colptrs, dim=0)
+        colptr = cat_offset(colptrs, nnz_offsets, skip_first=True)
 
     colcount: Optional[torch.Tensor] = None
     if len(colcounts) == len(tensors):
@@ -247,11 +278,11 @@ def cat_diag(tensors: List[SparseTensor]) -> SparseTensor:
 
     csr2csc: Optional[torch.Tensor] = None
     if len(csr2cscs) == len(tensors):
-        csr2csc = torch.cat(csr2cscs, dim=0)
+        csr2csc = cat_offset(csr2cscs, nnz_offsets)
 
     csc2csr: Optional[torch.Tensor] = None
     if len(csc2csrs) == len(tensors):
-        csc2csr = torch.cat(csc2csrs, dim=0)
+        csc2csr = cat_offset(csc2csrs, nnz_offsets)
 
     storage = SparseStorage(row=row, rowptr=rowptr, col=col, value=value,
                             sparse_sizes=(sparse_sizes[0], sparse_sizes[1]),
@@ -0,0 +1,64 @@
+from typing import Optional, Tuple
+
+import torch
+from torch_sparse.tensor import SparseTensor
+
+
+def compress(src: SparseTensor) -> Tuple[torch.Tensor, torch.Tensor,
+                                         torch.Tensor]:
+    """Compresses the column indices of :obj:`src` into per-row byte streams
+    of delta-encoded varints, and returns :obj:`(rowptr, byteptr, data)`.
+    Rows are addressed in :obj:`data` via :obj:`byteptr`, while
+    :obj:`rowptr` still addresses the (unchanged) non-zero values."""
+    rowptr = src.storage.rowptr()
+    byteptr, data = torch.ops.torch_sparse.compress_csr(
+        rowptr, src.storage.col())
+    return rowptr, byteptr, data
+
+
+def decompress(rowptr: torch.Tensor, byteptr: torch.Tensor,
+               data: torch.Tensor, value: Optional[torch.Tensor] = None,
+               sparse_sizes: Optional[Tuple[int, int]] = None) -> SparseTensor:
+    col = torch.ops.torch_sparse.decompress_csr(rowptr, byteptr, data)
+    return SparseTensor(rowptr=rowptr, col=col, value=value,
+                        sparse_sizes=sparse_sizes, is_sorted=True)
+
+
+def compressed_spmm(rowptr: torch.Tensor, byteptr: torch.Tensor,
+                    data: torch.Tensor, value: Optional[torch.Tensor],
+                    other: torch.Tensor, reduce: str = "sum") -> torch.Tensor:
+    if value is not None:
+        value = value.to(other.dtype)
+
+    out = torch.ops.torch_sparse.compressed_spmm(rowptr, byteptr, data, value,
+                                                 other)
+
+    if reduce == 'sum' or reduce == 'add':
+        return out
+    elif reduce == 'mean':
+        rowcount = (rowptr[1:] - rowptr[:-1]).clamp(min=1).to(other.dtype)
+        return out / rowcount.view(-1, 1)
+    else:
+        raise ValueError
+
+
+def compressed_sample_adj(
+        rowptr: torch.Tensor, byteptr: torch.Tensor, data: torch.Tensor,
+        value: Optional[torch.Tensor], subset: torch.Tensor,
+        num_neighbors: int,
+        replace: bool = False) -> Tuple[SparseTensor, torch.Tensor]:
+
+    rowptr, col, n_id, e_id = torch.ops.torch_sparse.compressed_sample_adj(
+        rowptr, byteptr, data, subset, num_neighbors, replace)
+
+    if value is not None:
+        value = value[e_id]
+
+    out = SparseTensor(rowptr=rowptr, row=None, col=col, value=value,
+                       sparse_sizes=(subset.size(0), n_id.size(0)),
+                       is_sorted=True)
+
+    return out, n_id
+
+
+SparseTensor.compress = compress
@@ -0,0 +1,73 @@
+from typing import Optional, Tuple
+
+import torch
+from torch_sparse.tensor import SparseTensor
+
+
+def gat_spmm(src: SparseTensor, alpha_dst: torch.Tensor,
+             alpha_src: torch.Tensor, other: torch.Tensor,
+             negative_slope: float = 0.2, return_attention: bool = False
+             ) -> Tuple[torch.Tensor, Optional[torch.Tensor]]:
+    r"""Fused GAT-style attention aggregation. For every non-zero entry
+    :math:`(i, j)` of :obj:`src`, computes the attention logit
+    :math:`e_{i,j} = \mathrm{LeakyReLU}(\alpha^{\textrm{dst}}_i +
+    \alpha^{\textrm{src}}_j)`, normalizes it via a row-wise softmax and
+    aggregates :math:`\sum_j \mathrm{softmax}_j(e_{i,j}) \cdot
+    \mathbf{x}_j` in a single pass. The values of :obj:`src` are ignored.
+
+    The attention coefficients of shape :obj:`[nnz]` or :obj:`[nnz, H]` are
+    only materialized if gradients are required or if
+    :obj:`return_attention` is set.
+
+    Args:
+        src (:class:`SparseTensor`): The sparsity pattern of shape
+            :obj:`[M, N]`.
+        alpha_dst (:class:`Tensor`): The row scores of shape :obj:`[M]` or
+            :obj:`[M, H]` (multi-head).
+        alpha_src (:class:`Tensor`): The column scores of shape :obj:`[N]` or
+            :obj:`[N, H]` (multi-head).
+        other (:class:`Tensor`): The column features of shape :obj:`[N, K]`
+            or :obj:`[N, H, K]` (multi-head).
+        negative_slope (float, optional): The LeakyReLU angle of the negative
+            slope. (default: :obj:`0.2`)
+        return_attention (bool, optional): If set to :obj:`True`, will
+            additionally return the normalized attention coefficients.
+            (default: :obj:`False`)
+
+    :rtype: (:class:`Tensor`, :class:`Tensor` or :obj:`None`)
+    """
+    assert alpha_dst.size(0) == src.sparse_size(0)
+    assert alpha_src.size(0) == src.sparse_size(1)
+    assert other.size(0) == src.sparse_size(1)
+
+    single_head = other.dim() == 2
+    if single_head:
+        alpha_dst = alpha_dst.view(-1, 1)
+        alpha_src = alpha_src.view(-1, 1)
+        other = other.unsqueeze(1)
+
+    rowptr, col, _ = src.csr()
+
+    row = src.storage._row
+    csr2csc = src.storage._csr2csc
+    colptr = src.storage._colptr
+
+    if alpha_src.requires_grad or other.requires_grad:
+        row = src.storage.row()
+        csr2csc = src.storage.csr2csc()
+        colptr = src.storage.colptr()
+
+    out, attention = torch.ops.torch_sparse.spmm_gat(
+        row, rowptr, col, colptr, csr2csc, alpha_dst, alpha_src, other,
+        negative_slope, return_attention)
+
+    if single_head:
+        out = out.squeeze(1)
+        attention = attention.view(-1)
+
+    if return_attention:
+        return out, attention
+    return out, None
+
+
+SparseTensor.gat_spmm = gat_spmm
@@ -11,6 +11,26 @@ def index_select(src: SparseTensor, dim: int,
     dim = src.dim() + dim if dim < 0 else dim
     assert idx.dim() == 1
 
+    if dim < 2 and not src.is_cuda():
+        rowptr, col, value = src.csr()
+        if dim == 0:
+            rowptr, col, perm = torch.ops.torch_sparse.index_select_row(
+                rowptr, col, idx)
+            sparse_sizes = (idx.size(0), src.sparse_size(1))
+        else:  # Select columns without converting to CSC:
+            rowptr, col, perm = torch.ops.torch_sparse.index_select_col(
+                rowptr, col, idx, src.sparse_size(1))
+            sparse_sizes = (src.sparse_size(0), idx.size(0))
+
+        if value is not None:
+            value = value[perm]
+
+        storage = SparseStorage(row=None, rowptr=rowptr, col=col, value=value,
+                                sparse_sizes=sparse_sizes, rowcount=None,
+                                colptr=None, colcount=None, csr2csc=None,
+                                csc2csr=None, is_sorted=True, trust_data=True)
+        return src.from_storage(storage)
+
     if dim == 0:
         old_rowptr, col, value = src.csr()
         rowcount = src.storage.rowcount()
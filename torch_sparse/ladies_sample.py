@@ -0,0 +1,40 @@
+from typing import List, Tuple
+
+import torch
+from torch_sparse.tensor import SparseTensor
+
+
+def ladies_sample(src: SparseTensor, input_node: torch.Tensor,
+                  layer_sizes: List[int]
+                  ) -> Tuple[List[torch.Tensor], List[SparseTensor]]:
+    r"""Layer-wise importance sampling from the `"Layer-Dependent Importance
+    Sampling for Training Deep and Large Graph Convolutional Networks"
+    <https://arxiv.org/abs/1911.07323>`_ paper.
+    :obj:`src` holds the transposed (normalized) adjacency, *i.e.*, incoming
+    edges per row. Returns the nodes of every layer, starting with
+    :obj:`input_node`, and the re-weighted bipartite adjacencies connecting
+    each layer to the next one."""
+    colptr, row, value = src.csr()
+
+    node, node_ptr, rowptr, col, _, weight = \
+        torch.ops.torch_sparse.ladies_sample(colptr, row, value, input_node,
+                                             layer_sizes)
+
+    node_ptr = node_ptr.tolist()
+    nodes = [node[node_ptr[i]:node_ptr[i + 1]]
+             for i in range(len(node_ptr) - 1)]
+
+    adjs: List[SparseTensor] = []
+    for i in range(len(layer_sizes)):
+        M, N = node_ptr[i + 1] - node_ptr[i], node_ptr[i + 2] - node_ptr[i + 1]
+        ptr = rowptr[node_ptr[i]:node_ptr[i + 1] + 1]
+        start, end = int(ptr[0]), int(ptr[-1])
+        adj = SparseTensor(rowptr=ptr - start, col=col[start:end],
+                           value=weight[start:end], sparse_sizes=(M, N),
+                           is_sorted=False)
+        adjs.append(adj)
+
+    return nodes, adjs
+
+
+SparseTensor.ladies_sample = ladies_sample
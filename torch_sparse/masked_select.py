@@ -1,6 +1,7 @@
 from typing import Optional
 
 import torch
+from torch_sparse.index_select import index_select
 from torch_sparse.storage import SparseStorage, get_layout
 from torch_sparse.tensor import SparseTensor
 
@@ -12,6 +13,9 @@ def masked_select(src: SparseTensor, dim: int,
     assert mask.dim() == 1
     storage = src.storage
 
+    if dim < 2 and not src.is_cuda():
+        return index_select(src, dim, mask.nonzero().flatten())
+
     if dim == 0:
         row, col, value = src.coo()
         rowcount = src.storage.rowcount()
@@ -1,11 +1,49 @@
-from typing import Tuple
+from typing import Optional, Tuple
 
 import torch
 
 from torch_sparse.tensor import SparseTensor
 
 
+def spmm_sell(src: SparseTensor, other: torch.Tensor) -> torch.Tensor:
+    sell = src.storage._sell
+    assert sell is not None
+    chunk_size, perm, chunkptr, col = sell[0], sell[2], sell[3], sell[4]
+    value = src.storage.sell_value().to(other.dtype)
+    return torch.ops.torch_sparse.sell_spmm(perm, chunkptr, col, value, other,
+                                            chunk_size)
+
+
+def spmm_bsr(src: SparseTensor, other: torch.Tensor) -> torch.Tensor:
+    bsr = src.storage._bsr
+    assert bsr is not None
+    browptr, bcol, bvalue = bsr[2], bsr[3], src.storage.bsr_value()
+    return torch.ops.torch_sparse.bsr_spmm(browptr, bcol,
+                                           bvalue.to(other.dtype), other,
+                                           src.sparse_size(0))
+
+
+def spmm_cached_layout(src: SparseTensor,
+                       other: torch.Tensor) -> Optional[torch.Tensor]:
+    # Cached BSR and SELL-C-sigma layouts only serve the forward pass on CPU:
+    if other.is_cuda or other.requires_grad:
+        return None
+    value = src.storage.value()
+    if value is not None and (value.dim() != 1 or value.requires_grad):
+        return None
+
+    if src.storage.has_bsr():
+        return spmm_bsr(src, other)
+    if src.storage.has_sell():
+        return spmm_sell(src, other)
+    return None
+
+
 def spmm_sum(src: SparseTensor, other: torch.Tensor) -> torch.Tensor:
+    out = spmm_cached_layout(src, other)
+    if out is not None:
+        return out
+
     rowptr, col, value = src.csr()
 
     row = src.storage._row
@@ -32,6 +70,11 @@ def spmm_add(src: SparseTensor, other: torch.Tensor) -> torch.Tensor:
 
 
 def spmm_mean(src: SparseTensor, other: torch.Tensor) -> torch.Tensor:
+    out = spmm_cached_layout(src, other)
+    if out is not None:
+        rowcount = src.storage.rowcount().clamp(min=1).to(other.dtype)
+        return out / rowcount.view(-1, 1)
+
     rowptr, col, value = src.csr()
 
     row = src.storage._row
@@ -94,10 +137,11 @@ def spspmm_sum(src: SparseTensor, other: SparseTensor) -> SparseTensor:
     rowptrA, colA, valueA = src.csr()
     rowptrB, colB, valueB = other.csr()
     value = valueA if valueA is not None else valueB
-    if valueA is not None and valueA.dtype == torch.half:
-        valueA = valueA.to(torch.float)
-    if valueB is not None and valueB.dtype == torch.half:
-        valueB = valueB.to(torch.float)
+    if src.is_cuda():  # cuSPARSE does not support reduced precision types.
+        if valueA is not None and valueA.dtype in [torch.half, torch.bfloat16]:
+            valueA = valueA.to(torch.float)
+        if valueB is not None and valueB.dtype in [torch.half, torch.bfloat16]:
+            valueB = valueB.to(torch.float)
     M, K = src.sparse_size(0), other.sparse_size(1)
     rowptrC, colC, valueC = torch.ops.torch_sparse.spspmm_sum(
         rowptrA, colA, valueA, rowptrB, colB, valueB, K)
@@ -21,10 +21,16 @@ def weight2metis(weight: torch.Tensor) -> Optional[torch.Tensor]:
 
 def partition(
     src: SparseTensor, num_parts: int, recursive: bool = False,
-    weighted: bool = False, node_weight: Optional[torch.Tensor] = None
+    weighted: bool = False, node_weight: Optional[torch.Tensor] = None,
+    method: str = 'metis', num_workers: int = 0
 ) -> Tuple[SparseTensor, torch.Tensor, torch.Tensor]:
+    r"""Partitions :obj:`src` into :obj:`num_parts` clusters via METIS, or
+    via the built-in streaming partitioners :obj:`method="ldg"` (Linear
+    Deterministic Greedy) and :obj:`method="fennel"`, which do not require
+    METIS and run on :obj:`num_workers` threads (all threads if :obj:`0`)."""
 
     assert num_parts >= 1
+    assert method in ['metis', 'ldg', 'fennel']
     if num_parts == 1:
         partptr = torch.tensor([0, src.size(0)], device=src.device())
         perm = torch.arange(src.size(0), device=src.device())
@@ -46,6 +52,12 @@ def partition(
         node_weight = node_weight.view(-1).detach().cpu()
         if node_weight.is_floating_point():
             node_weight = weight2metis(node_weight)
+
+    if method != 'metis':
+        cluster = torch.ops.torch_sparse.stream_partition(
+            rowptr, col, value, node_weight, num_parts, method == 'fennel',
+            num_workers)
+    elif node_weight is not None:
         cluster = torch.ops.torch_sparse.partition2(rowptr, col, value,
                                                     node_weight, num_parts,
                                                     recursive)
@@ -61,4 +73,27 @@ def partition(
     return out, partptr, perm
 
 
+def cluster_subgraph(src: SparseTensor, partptr: torch.Tensor,
+                     cluster: torch.Tensor
+                     ) -> Tuple[SparseTensor, torch.Tensor]:
+    r"""Returns the subgraph induced by the union of the clusters
+    :obj:`cluster` of a graph partitioned via :meth:`partition`, together
+    with its node indices, *e.g.*, to assemble Cluster-GCN mini-batches."""
+    rowptr, col, value = src.csr()
+    cluster = cluster.sort()[0]
+
+    node, rowptr, col, edge_index = torch.ops.torch_sparse.cluster_subgraph(
+        rowptr, col, partptr, cluster)
+
+    if value is not None:
+        value = value[edge_index]
+
+    out = SparseTensor(rowptr=rowptr, col=col, value=value,
+                       sparse_sizes=(node.numel(), node.numel()),
+                       is_sorted=True)
+
+    return out, node
+
+
 SparseTensor.partition = partition
+SparseTensor.cluster_subgraph = cluster_subgraph
@@ -0,0 +1,70 @@
+from typing import List, Optional, Tuple
+
+import torch
+from torch_sparse.storage import SparseStorage
+from torch_sparse.tensor import SparseTensor
+
+
+def to_sections(src: SparseTensor) -> List[Optional[torch.Tensor]]:
+    storage = src.storage
+    return [
+        storage.rowptr(), storage.col(), storage.value(), storage._colptr,
+        storage._csr2csc, storage._row, storage._rowcount, storage._colcount,
+        storage._csc2csr
+    ]
+
+
+def from_sections(
+    out: Tuple[torch.Tensor, torch.Tensor, Optional[torch.Tensor],
+               Optional[torch.Tensor], Optional[torch.Tensor],
+               Optional[torch.Tensor], Optional[torch.Tensor],
+               Optional[torch.Tensor], Optional[torch.Tensor], int, int]
+) -> SparseTensor:
+    (rowptr, col, value, colptr, csr2csc, row, rowcount, colcount, csc2csr,
+     M, N) = out
+    storage = SparseStorage(row=row, rowptr=rowptr, col=col, value=value,
+                            sparse_sizes=(M, N), rowcount=rowcount,
+                            colptr=colptr, colcount=colcount, csr2csc=csr2csc,
+                            csc2csr=csc2csr, is_sorted=True, trust_data=True)
+    return SparseTensor.from_storage(storage)
+
+
+def save_csr(src: SparseTensor, path: str):
+    """Saves the CSR representation of :obj:`src` (including all of its
+    cached tensors) to a binary file that can be memory-mapped via
+    :meth:`load_csr`."""
+    src = src.cpu()
+    torch.ops.torch_sparse.csr_save(path, *to_sections(src),
+                                    src.sparse_size(0), src.sparse_size(1))
+
+
+def load_csr(path: str) -> SparseTensor:
+    """Memory-maps a file written by :meth:`save_csr` and wraps its sections
+    as tensors without copying. Pages are only read on access and are shared
+    across processes via the page cache. Writes to the returned tensors stay
+    private to the process and never reach the file."""
+    return from_sections(torch.ops.torch_sparse.csr_load(path))
+
+
+def create_shared_store(src: SparseTensor, name: str):
+    """Creates a named, read-only shared memory graph store holding
+    :obj:`src` together with all of its cached layouts, which get computed
+    beforehand. Processes attach to it via :meth:`attach_shared_store`, so
+    that memory usage stays flat in the number of processes. The store
+    lives until it gets removed via :meth:`unlink_shared_store`."""
+    src = src.cpu().fill_cache_()
+    torch.ops.torch_sparse.shm_store_create(name, *to_sections(src),
+                                            src.sparse_size(0),
+                                            src.sparse_size(1))
+
+
+def attach_shared_store(name: str) -> SparseTensor:
+    """Attaches to the shared memory graph store :obj:`name` without copying
+    any data. Writes to the returned tensors stay private to the process."""
+    return from_sections(torch.ops.torch_sparse.shm_store_attach(name))
+
+
+def unlink_shared_store(name: str):
+    """Removes the shared memory graph store :obj:`name`. Attached processes
+    keep access to their data until they release it."""
+    torch.ops.torch_sparse.shm_store_unlink(name)
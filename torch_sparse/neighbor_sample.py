@@ -0,0 +1,45 @@
+from typing import Iterator, List, Optional, Tuple
+
+import torch
+from torch_sparse.tensor import SparseTensor
+
+
+def neighbor_sample_gather(
+    src: SparseTensor, input_node: torch.Tensor, num_neighbors: List[int],
+    replace: bool = False, directed: bool = True,
+    x: Optional[torch.Tensor] = None, x_out: Optional[torch.Tensor] = None,
+    edge_attr: Optional[torch.Tensor] = None,
+    edge_out: Optional[torch.Tensor] = None
+) -> Tuple[torch.Tensor, torch.Tensor, torch.Tensor, torch.Tensor,
+           Optional[torch.Tensor], Optional[torch.Tensor]]:
+    r"""Samples a subgraph via :obj:`neighbor_sample` and gathers node
+    features :obj:`x[node]` and edge features :obj:`edge_attr[edge]` in the
+    same call. If given, features are written into the leading rows of the
+    preallocated buffers :obj:`x_out` and :obj:`edge_out`.
+    :obj:`edge_attr` is ordered like the non-zeros of :obj:`src`."""
+    colptr, row, _ = src.csr()
+    return torch.ops.torch_sparse.neighbor_sample_gather(
+        colptr, row, input_node, num_neighbors, replace, directed, x, x_out,
+        edge_attr, edge_out)
+
+
+def neighbor_sample_loader(
+    src: SparseTensor, input_node: torch.Tensor, num_neighbors: List[int],
+    batch_size: int, replace: bool = False, directed: bool = True,
+    num_workers: int = 2, queue_size: int = 4
+) -> Iterator[Tuple[torch.Tensor, torch.Tensor, torch.Tensor, torch.Tensor]]:
+    r"""Iterates over :obj:`(node, row, col, edge)` subgraphs sampled via
+    :obj:`neighbor_sample` for consecutive batches of :obj:`input_node`.
+    Batches get sampled ahead of time by :obj:`num_workers` native threads,
+    of which at most :obj:`queue_size` are buffered.
+    :obj:`src` holds the transposed adjacency, *i.e.*, incoming edges per
+    row."""
+    colptr, row, _ = src.csr()
+    pipeline = torch.classes.torch_sparse.NeighborSamplerPipeline(
+        colptr, row, input_node, batch_size, num_neighbors, replace, directed,
+        num_workers, queue_size)
+    while True:
+        out = pipeline.next()
+        if len(out) == 0:
+            return
+        yield out[0], out[1], out[2], out[3]
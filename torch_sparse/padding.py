@@ -18,4 +18,48 @@ def padded_index_select(src: torch.Tensor, index: torch.Tensor,
     return torch.ops.torch_sparse.padded_index_select(src, index, fill_value)
 
 
+def padded_spmm(src: SparseTensor, other: torch.Tensor, binptr: torch.Tensor,
+                reduce: str = 'sum') -> torch.Tensor:
+    r"""Sum- or mean-aggregates :obj:`other` of shape :obj:`[N, F]` along
+    :obj:`src` via the degree-binned, padded layout of :meth:`padded_index`.
+    Neighbors of every bin get gathered into a dense
+    :obj:`[node_size, max_degree, F]` block, in which padding entries hold
+    zeros, and are reduced in a single batched operation per bin. This
+    vectorizes much better than CSR for bins of low degree variance."""
+    assert other.dim() == 2 and reduce in ['sum', 'add', 'mean']
+
+    node_perm, row_perm, col_perm, mask, node_size, edge_size = padded_index(
+        src, binptr)
+    length = [e // max(n, 1) for n, e in zip(node_size, edge_size)]
+    x = padded_index_select(other, col_perm, fill_value=0.)
+
+    value = src.storage.value()
+    if value is not None:
+        assert value.dim() == 1
+        # Slot `k` of row `n` holds edge `rowptr[n] + k`:
+        slot = torch.cat([
+            torch.arange(edge_size[b], device=col_perm.device) %
+            max(length[b], 1) for b in range(len(edge_size))
+        ])
+        edge = src.storage.rowptr()[row_perm.clamp(min=0)] + slot
+        value = value[edge.masked_fill(mask, 0)].masked_fill(mask, 0)
+        x = x * value.view(-1, 1).to(x.dtype)
+
+    outs: List[torch.Tensor] = []
+    offset = 0
+    for b in range(len(node_size)):
+        block = x[offset:offset + edge_size[b]]
+        block = block.view(node_size[b], length[b], x.size(-1))
+        outs.append(block.sum(dim=1))
+        offset += edge_size[b]
+    out = torch.cat(outs, dim=0)
+
+    if reduce == 'mean':
+        rowcount = src.storage.rowcount()[node_perm]
+        out = out / rowcount.clamp(min=1).view(-1, 1).to(out.dtype)
+
+    return out.new_zeros(src.size(0), out.size(-1)).index_copy(
+        0, node_perm, out)
+
+
 SparseTensor.padded_index = padded_index
@@ -1,10 +1,25 @@
 import torch
+from torch_sparse.storage import SparseStorage
 from torch_sparse.tensor import SparseTensor
 
 
 def permute(src: SparseTensor, perm: torch.Tensor) -> SparseTensor:
     assert src.is_quadratic()
-    return src.index_select(0, perm).index_select(1, perm)
+
+    if src.is_cuda():
+        return src.index_select(0, perm).index_select(1, perm)
+
+    rowptr, col, value = src.csr()
+    rowptr, col, perm = torch.ops.torch_sparse.permute(rowptr, col, perm)
+
+    if value is not None:
+        value = value[perm]
+
+    storage = SparseStorage(row=None, rowptr=rowptr, col=col, value=value,
+                            sparse_sizes=src.sparse_sizes(), rowcount=None,
+                            colptr=None, colcount=None, csr2csc=None,
+                            csc2csr=None, is_sorted=True, trust_data=True)
+    return src.from_storage(storage)
 
 
 SparseTensor.permute = lambda self, perm: permute(self, perm)
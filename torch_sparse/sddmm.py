@@ -0,0 +1,39 @@
+import torch
+from torch_sparse.tensor import SparseTensor
+
+
+def sddmm(src: SparseTensor, x: torch.Tensor, y: torch.Tensor) -> torch.Tensor:
+    r"""Sampled dense-dense matrix multiplication. Computes the dot product
+    :math:`\langle \mathbf{x}_i, \mathbf{y}_j \rangle` for every non-zero
+    entry :math:`(i, j)` of :obj:`src`, without materializing the gathered
+    node features. The values of :obj:`src` are ignored.
+
+    Args:
+        src (:class:`SparseTensor`): The sparsity pattern of shape
+            :obj:`[M, N]`.
+        x (:class:`Tensor`): The row features of shape :obj:`[M, K]` or
+            :obj:`[M, H, K]` (multi-head).
+        y (:class:`Tensor`): The column features of shape :obj:`[N, K]` or
+            :obj:`[N, H, K]` (multi-head).
+
+    :rtype: :class:`Tensor` of shape :obj:`[nnz]` or :obj:`[nnz, H]`
+    """
+    assert x.size(0) == src.sparse_size(0)
+    assert y.size(0) == src.sparse_size(1)
+
+    rowptr, col, _ = src.csr()
+
+    row = src.storage._row
+    csr2csc = src.storage._csr2csc
+    colptr = src.storage._colptr
+
+    if y.requires_grad:
+        row = src.storage.row()
+        csr2csc = src.storage.csr2csc()
+        colptr = src.storage.colptr()
+
+    return torch.ops.torch_sparse.sddmm(row, rowptr, col, colptr, csr2csc, x,
+                                        y)
+
+
+SparseTensor.sddmm = lambda self, x, y: sddmm(self, x, y)
@@ -0,0 +1,52 @@
+from typing import Optional
+
+import torch
+from torch_sparse.tensor import SparseTensor
+
+
+def softmax(src: SparseTensor, dim: int = 1,
+            inplace: bool = False) -> SparseTensor:
+    r"""Computes a numerically stable softmax over the non-zero values of
+    each row (:obj:`dim=1`) or column (:obj:`dim=0`) of :obj:`src`.
+    Multi-head values of shape :obj:`[nnz, H]` are normalized per head.
+
+    Args:
+        src (:class:`SparseTensor`): The sparse input matrix.
+        dim (int, optional): The sparse dimension to normalize over.
+            (default: :obj:`1`)
+        inplace (bool, optional): If set to :obj:`True`, will overwrite the
+            values of :obj:`src` for row-wise normalization.
+            (default: :obj:`False`)
+
+    :rtype: :class:`SparseTensor`
+    """
+    dim = src.dim() + dim if dim < 0 else dim
+
+    # Freshly allocated values can always be normalized in place:
+    value: Optional[torch.Tensor] = src.storage.value()
+    owned = value is None
+    if value is None:
+        value = torch.ones(src.nnz(), dtype=src.dtype(), device=src.device())
+    assert value.dim() <= 2
+
+    if dim == 1:
+        out = torch.ops.torch_sparse.sparse_softmax(src.storage.rowptr(),
+                                                    value, inplace or owned)
+        if inplace:
+            return src.set_value_(out, layout='coo')
+        return src.set_value(out, layout='coo')
+
+    elif dim == 0:
+        value = value[src.storage.csr2csc()]
+        out = torch.ops.torch_sparse.sparse_softmax(src.storage.colptr(),
+                                                    value, True)
+        if inplace:
+            return src.set_value_(out, layout='csc')
+        return src.set_value(out, layout='csc')
+
+    else:
+        raise ValueError
+
+
+SparseTensor.softmax = lambda self, dim=1, inplace=False: softmax(
+    self, dim, inplace)
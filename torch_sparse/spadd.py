@@ -1,5 +1,5 @@
 import torch
-from torch_sparse import coalesce
+from torch_sparse.tensor import SparseTensor
 
 
 def spadd(indexA, valueA, indexB, valueB, m, n):
@@ -13,6 +13,9 @@ def spadd(indexA, valueA, indexB, valueB, m, n):
         m (int): The first dimension of the sparse matrices.
         n (int): The second dimension of the sparse matrices.
     """
-    index = torch.cat([indexA, indexB], dim=-1)
-    value = torch.cat([valueA, valueB], dim=0)
-    return coalesce(index=index, value=value, m=m, n=n, op='add')
+    A = SparseTensor(row=indexA[0], col=indexA[1], value=valueA,
+                     sparse_sizes=(m, n))
+    B = SparseTensor(row=indexB[0], col=indexB[1], value=valueB,
+                     sparse_sizes=(m, n))
+    row, col, value = A.add(B).coo()
+    return torch.stack([row, col], dim=0), value
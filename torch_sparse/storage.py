@@ -29,6 +29,10 @@ class SparseStorage(object):
     _colcount: Optional[torch.Tensor]
     _csr2csc: Optional[torch.Tensor]
     _csc2csr: Optional[torch.Tensor]
+    _sell: Optional[Tuple[int, int, torch.Tensor, torch.Tensor, torch.Tensor,
+                          torch.Tensor, Optional[torch.Tensor]]]
+    _bsr: Optional[Tuple[int, int, torch.Tensor, torch.Tensor, torch.Tensor,
+                         Optional[torch.Tensor]]]
 
     def __init__(
         self,
@@ -144,20 +148,34 @@ class SparseStorage(object):
         self._colcount = colcount
         self._csr2csc = csr2csc
         self._csc2csr = csc2csr
+        self._sell = None
+        self._bsr = None
+
+        if not is_sorted and not self._col.is_cuda:
+            # Avoid computing keys in case indices are already sorted:
+            is_sorted = torch.ops.torch_sparse.is_sorted(
+                self.row(), self._col, False)
+        elif not is_sorted and self._col.numel() > 0:
+            # Pairwise check, which is cheap compared to sorting:
+            r, c = self.row(), self._col
+            is_sorted = not bool(((r[1:] < r[:-1]) | ((r[1:] == r[:-1]) &
+                                                      (c[1:] < c[:-1]))).any())
 
         if not is_sorted:
-            idx = self._col.new_zeros(self._col.numel() + 1)
-            idx[1:] = self.row()
-            idx[1:] *= self._sparse_sizes[1]
-            idx[1:] += self._col
-            if (idx[1:] < idx[:-1]).any():
-                perm = idx[1:].argsort()
-                self._row = self.row()[perm]
-                self._col = self._col[perm]
-                if value is not None:
-                    self._value = value[perm]
-                self._csr2csc = None
-                self._csc2csr = None
+            # Sort by `(row, col)` without forming `row * N + col` keys,
+            # which overflow for large sparse sizes:
+            if not self._col.is_cuda:
+                perm = torch.ops.torch_sparse.sort_coo(
+                    self.row(), self._col, self._sparse_sizes[0])
+            else:
+                perm = self._col.sort(stable=True)[1]
+                perm = perm[self.row()[perm].sort(stable=True)[1]]
+            self._row = self.row()[perm]
+            self._col = self._col[perm]
+            if value is not None:
+                self._value = value[perm]
+            self._csr2csc = None
+            self._csc2csr = None
 
     @classmethod
     def empty(self):
@@ -219,6 +237,13 @@ class SparseStorage(object):
             assert value.size(0) == self._col.numel()
 
         self._value = value
+        sell = self._sell
+        if sell is not None:  # Drop cached packed values:
+            self._sell = (sell[0], sell[1], sell[2], sell[3], sell[4],
+                          sell[5], None)
+        bsr = self._bsr
+        if bsr is not None:  # Drop cached block values:
+            self._bsr = (bsr[0], bsr[1], bsr[2], bsr[3], bsr[4], None)
         return self
 
     def set_value(self, value: Optional[torch.Tensor],
@@ -230,7 +255,7 @@ class SparseStorage(object):
             assert value.device == self._col.device
             assert value.size(0) == self._col.numel()
 
-        return SparseStorage(
+        out = SparseStorage(
             row=self._row,
             rowptr=self._rowptr,
             col=self._col,
@@ -244,6 +269,15 @@ class SparseStorage(object):
             is_sorted=True,
             trust_data=True,
         )
+        # Cached block layouts do not depend on values:
+        sell = self._sell
+        if sell is not None:
+            out._sell = (sell[0], sell[1], sell[2], sell[3], sell[4], sell[5],
+                         None)
+        bsr = self._bsr
+        if bsr is not None:
+            out._bsr = (bsr[0], bsr[1], bsr[2], bsr[3], bsr[4], None)
+        return out
 
     def sparse_sizes(self) -> Tuple[int, int]:
         return self._sparse_sizes
@@ -405,12 +439,115 @@ class SparseStorage(object):
         self._csc2csr = csc2csr
         return csc2csr
 
+    def has_sell(self) -> bool:
+        return self._sell is not None
+
+    def sell(
+        self, chunk_size: int = 8, sigma: int = 256
+    ) -> Tuple[torch.Tensor, torch.Tensor, torch.Tensor, torch.Tensor]:
+        # SELL-C-sigma layout `(perm, chunkptr, col, eperm)`, see
+        # `csrc/cpu/sell_cpu.cpp`. Cached for the given pair of arguments.
+        sell = self._sell
+        if sell is not None and sell[0] == chunk_size and sell[1] == sigma:
+            return sell[2], sell[3], sell[4], sell[5]
+
+        perm, chunkptr, col, eperm = torch.ops.torch_sparse.to_sell(
+            self.rowptr(), self._col, chunk_size, sigma)
+        self._sell = (chunk_size, sigma, perm, chunkptr, col, eperm, None)
+        return perm, chunkptr, col, eperm
+
+    def sell_value(self) -> torch.Tensor:
+        # Values in the packed order of the cached SELL-C-sigma layout, in
+        # which padding entries hold zeros. Cached until values get replaced.
+        sell = self._sell
+        assert sell is not None
+        chunk_size, sigma, perm, chunkptr, col, eperm, svalue = sell
+        if svalue is not None:
+            return svalue
+
+        value = self._value
+        if value is None:
+            svalue = (eperm >= 0).to(torch.float)
+        else:
+            assert value.dim() == 1
+            svalue = value[eperm.clamp(min=0)].masked_fill(eperm < 0, 0)
+        if not svalue.requires_grad:
+            self._sell = (chunk_size, sigma, perm, chunkptr, col, eperm,
+                          svalue)
+        return svalue
+
+    def has_bsr(self) -> bool:
+        return self._bsr is not None
+
+    def bsr(self, R: int,
+            C: int) -> Tuple[torch.Tensor, torch.Tensor, torch.Tensor]:
+        # BSR layout `(browptr, bcol, pos)` with blocks of shape `[R, C]`,
+        # see `csrc/cpu/bsr_cpu.cpp`. Cached for the given block shape.
+        bsr = self._bsr
+        if bsr is not None and bsr[0] == R and bsr[1] == C:
+            return bsr[2], bsr[3], bsr[4]
+
+        browptr, bcol, pos = torch.ops.torch_sparse.csr2bsr(
+            self.rowptr(), self._col, R, C)
+        self._bsr = (R, C, browptr, bcol, pos, None)
+        return browptr, bcol, pos
+
+    def bsr_value(self) -> torch.Tensor:
+        # Block values of shape `[nnzb, R, C]` of the cached BSR layout.
+        # Cached until values get replaced.
+        bsr = self._bsr
+        assert bsr is not None
+        R, C, browptr, bcol, pos, bvalue = bsr
+        if bvalue is not None:
+            return bvalue
+
+        value = self._value
+        if value is None:
+            value = torch.ones(pos.numel(), device=pos.device)
+        assert value.dim() == 1
+
+        bvalue = value.new_zeros(bcol.numel() * R * C).index_add(0, pos, value)
+        bvalue = bvalue.view(-1, R, C)
+        if not bvalue.requires_grad:
+            self._bsr = (R, C, browptr, bcol, pos, bvalue)
+        return bvalue
+
     def is_coalesced(self) -> bool:
+        if not self._col.is_cuda:
+            return torch.ops.torch_sparse.is_sorted(self.row(), self._col,
+                                                    True)
+
         idx = self._col.new_full((self._col.numel() + 1, ), -1)
         idx[1:] = self._sparse_sizes[1] * self.row() + self._col
         return bool((idx[1:] > idx[:-1]).all())
 
     def coalesce(self, reduce: str = "add"):
+        if not self._col.is_cuda:
+            if self.is_coalesced():  # Skip if indices are already coalesced.
+                return self
+
+            rowptr, col, ptr = torch.ops.torch_sparse.coalesce(
+                self.rowptr(), self._col)
+
+            value = self._value
+            if value is not None:
+                value = segment_csr(value, ptr, reduce=reduce)
+
+            return SparseStorage(
+                row=None,
+                rowptr=rowptr,
+                col=col,
+                value=value,
+                sparse_sizes=self._sparse_sizes,
+                rowcount=None,
+                colptr=None,
+                colcount=None,
+                csr2csc=None,
+                csc2csr=None,
+                is_sorted=True,
+                trust_data=True,
+            )
+
         idx = self._col.new_full((self._col.numel() + 1, ), -1)
         idx[1:] = self._sparse_sizes[1] * self.row() + self._col
         mask = idx[1:] > idx[:-1]
@@ -458,6 +595,8 @@ class SparseStorage(object):
         self._colcount = None
         self._csr2csc = None
         self._csc2csr = None
+        self._sell = None
+        self._bsr = None
         return self
 
     def cached_keys(self) -> List[str]:
@@ -472,13 +611,17 @@ class SparseStorage(object):
             keys.append('csr2csc')
         if self.has_csc2csr():
             keys.append('csc2csr')
+        if self.has_sell():
+            keys.append('sell')
+        if self.has_bsr():
+            keys.append('bsr')
         return keys
 
     def num_cached_keys(self) -> int:
         return len(self.cached_keys())
 
     def copy(self):
-        return SparseStorage(
+        out = SparseStorage(
             row=self._row,
             rowptr=self._rowptr,
             col=self._col,
@@ -492,6 +635,9 @@ class SparseStorage(object):
             is_sorted=True,
             trust_data=True,
         )
+        out._sell = self._sell
+        out._bsr = self._bsr
+        return out
 
     def clone(self):
         row = self._row
@@ -4,7 +4,7 @@ from typing import Any, Dict, List, Optional, Tuple, Union
 import numpy as np
 import scipy.sparse
 import torch
-from torch_scatter import segment_csr
+from torch_scatter import scatter, segment_csr
 
 from torch_sparse.storage import SparseStorage, get_layout
 
@@ -340,6 +340,10 @@ class SparseTensor(object):
         if not self.is_quadratic():
             return False
 
+        if not self.is_cuda():
+            rowptr, col, value = self.csr()
+            return torch.ops.torch_sparse.is_symmetric(rowptr, col, value)
+
         rowptr, col, value1 = self.csr()
         colptr, row, value2 = self.csc()
 
@@ -354,6 +358,22 @@ class SparseTensor(object):
     def to_symmetric(self, reduce: str = "sum"):
         N = max(self.size(0), self.size(1))
 
+        if not self.is_cuda():
+            # Merge every row of `A` with its corresponding row of `A^T`:
+            rowptr, col, value = self.csr()
+            # Reuse the cached transpose of `A` if present:
+            colptr, csr2csc = self.storage._colptr, self.storage._csr2csc
+            out = torch.ops.torch_sparse.to_symmetric(rowptr, col, N, colptr,
+                                                      csr2csc)
+            rowptr, col, csr2csc, perm1, perm2 = out
+            if value is not None:
+                value = torch.cat([value, value[csr2csc]], dim=0)
+                value = scatter(value, torch.cat([perm1, perm2], dim=0),
+                                dim=0, dim_size=col.numel(), reduce=reduce)
+            return SparseTensor(rowptr=rowptr, col=col, value=value,
+                                sparse_sizes=(N, N), is_sorted=True,
+                                trust_data=True)
+
         row, col, value = self.coo()
         idx = col.new_full((2 * col.numel() + 1, ), -1)
         idx[1:row.numel() + 1] = row